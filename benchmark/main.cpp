@@ -0,0 +1,13 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the 
+// root directory of this distribution.
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv)
+{
+   ::benchmark::Initialize(&argc, argv);
+   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+      return 1;
+   ::benchmark::RunSpecifiedBenchmarks();
+}
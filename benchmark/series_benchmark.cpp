@@ -0,0 +1,64 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the 
+// root directory of this distribution.
+
+// Measures how series grouping scales with the number of benchmarks in the
+// input. Each generated series has a fixed number of benchmarks, hence the
+// number of series grows linearly with the number of benchmarks.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "gb2gc.h"
+
+namespace
+{
+   constexpr int benchmarks_per_series = 16;
+
+   // Generates a Google Benchmark result with the given number of benchmarks
+   // named 'BM_<series>/<arg>'.
+   nlohmann::json make_result(int benchmarks)
+   {
+      auto result = nlohmann::json::object();
+      auto& array = result["benchmarks"] = nlohmann::json::array();
+      for (auto i = 0; i < benchmarks; ++i)
+      {
+         const auto series = i / benchmarks_per_series;
+         const auto arg = i % benchmarks_per_series;
+         array.push_back({
+            { "name", "BM_" + std::to_string(series) + "/" + std::to_string(arg) },
+            { "real_time", 100.0 + i },
+            { "cpu_time", 90.0 + i }
+         });
+      }
+      return result;
+   }
+}
+
+static void BM_make_series(benchmark::State& state)
+{
+   const char* args[] = { "gb2gc_benchmark", "-i", "-", "-o", "-", "-c", "line",
+      "-s", "name/1", "real_time" };
+   gb2gc::options options;
+   if (options.parse(10, args) != 0)
+   {
+      state.SkipWithError("Failed to parse options");
+      return;
+   }
+
+   const auto result = make_result(static_cast<int>(state.range(0)));
+   for (auto _ : state)
+   {
+      auto ds = gb2gc::parse_data(options, result);
+      benchmark::DoNotOptimize(ds);
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+   state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_make_series)
+   ->RangeMultiplier(4)->Range(1 << 8, 1 << 16)
+   ->Unit(benchmark::kMillisecond)
+   ->Complexity();
@@ -0,0 +1,70 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+// Compares the statistics kernels of each instruction set against the scalar
+// kernels over a contiguous column of doubles. Instruction sets not supported
+// by the executing CPU fall back to a supported one.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "stats_kernels.h"
+
+namespace
+{
+   std::vector<double> make_column(std::size_t n)
+   {
+      std::vector<double> values(n);
+      for (auto i = std::size_t(0); i < n; ++i)
+         values[i] = 100.0 + static_cast<double>(i % 1000) * 0.25;
+      return values;
+   }
+
+   const gb2gc::stats_kernels& kernels(const benchmark::State& state)
+   {
+      return gb2gc::get_stats_kernels(static_cast<gb2gc::instruction_set>(state.range(1)));
+   }
+
+   void arguments(benchmark::internal::Benchmark* b)
+   {
+      for (auto isa : { gb2gc::instruction_set::scalar, gb2gc::instruction_set::sse2,
+         gb2gc::instruction_set::avx2 })
+      {
+         for (auto n = 1 << 10; n <= 1 << 20; n <<= 5)
+            b->Args({ n, static_cast<int>(isa) });
+      }
+   }
+}
+
+static void BM_sum(benchmark::State& state)
+{
+   const auto& k = kernels(state);
+   const auto values = make_column(static_cast<std::size_t>(state.range(0)));
+   for (auto _ : state)
+      benchmark::DoNotOptimize(k.sum(values.data(), values.size()));
+   state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+
+static void BM_minimum(benchmark::State& state)
+{
+   const auto& k = kernels(state);
+   const auto values = make_column(static_cast<std::size_t>(state.range(0)));
+   for (auto _ : state)
+      benchmark::DoNotOptimize(k.minimum(values.data(), values.size()));
+   state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+
+static void BM_sum_squared_deviations(benchmark::State& state)
+{
+   const auto& k = kernels(state);
+   const auto values = make_column(static_cast<std::size_t>(state.range(0)));
+   for (auto _ : state)
+      benchmark::DoNotOptimize(k.sum_squared_deviations(values.data(), values.size(), 200.0));
+   state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(double)));
+}
+
+BENCHMARK(BM_sum)->Apply(arguments);
+BENCHMARK(BM_minimum)->Apply(arguments);
+BENCHMARK(BM_sum_squared_deviations)->Apply(arguments);
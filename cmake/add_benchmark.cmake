@@ -146,10 +146,15 @@ endfunction()
 #
 # gb2gc_add_benchmark_chart(
 #   TARGET target
+#   INPUT input1 [input2] ...
 #   BM_OUT output  
 #   [HTML_OUTPUT html_output]
 #   [OPTIONS option1 [options2] ...]
 #   [GB2GC_OPTIONS option1 [option2] ...]
+#   [FILTER pattern1 [pattern2] ...]
+#   [SNAPSHOT]
+#   [DASHBOARD]
+#   [MANIFEST manifest]
 #   [WORKING_DIRECTORY dir]
 # )
 #
@@ -166,12 +171,34 @@ endfunction()
 # BM_COLOR
 # BM_REPORT_AGGREGATES_ONLY
 #
+# DASHBOARD
+#   Generate a single page with one chart per series, sharing a single 
+#   loader and a single embedded data table, instead of a single chart.
+#   Forwards '--dashboard' to gb2gc.
+#
+# FILTER
+#   Specifies one or more benchmark name patterns. Patterns are segment 
+#   globs, e.g. 'BM_memcpy/*', regular expressions prefixed with 're:' or 
+#   either of them prefixed with '-' to exclude matching benchmarks.
+#   Forwards '-f <pattern1> [pattern2] ...' to gb2gc.
+#
+# INPUT
+#   Specifies one or more benchmark JSON files to be converted. Multiple 
+#   files are parsed concurrently and merged into a single chart.
+#
 # HTML_OUTPUT 
 #   Specifies the HTML output file to be generated with a chart representation
 #   of the benchmark result. If the output path is a relative path it will be 
 #   interpreted as relative to the working directory which defaults to the 
 #   build tree current binary directory.  
 #
+# MANIFEST
+#   Adds the chart to the given manifest instead of generating it by a 
+#   separate invocation of gb2gc. No chart target is added, instead all charts
+#   of the manifest are generated by the target added by 
+#   gb2gc_add_chart_manifest(...) for the same manifest. Input and output 
+#   paths are made absolute relative to the working directory.
+#
 # OPTIONS
 #   Allows to override 
 #   See: https://github.com/google/benchmark#command-line
@@ -182,6 +209,12 @@ endfunction()
 #   to the working directory which defaults to the build tree current binary 
 #   directory. 
 #
+# SNAPSHOT
+#   Cache the parsed input in a binary snapshot next to the input file. 
+#   Charts generated from the same input reuse the snapshot instead of 
+#   parsing the input again as long as the input is unchanged.
+#   Forwards '--snapshot' to gb2gc.
+#
 # TARGET
 #   Specifies an existing CMake target representing a Google Benchmark 
 #   executable.
@@ -195,9 +228,9 @@ endfunction()
 function(gb2gc_add_benchmark_chart)
    cmake_parse_arguments(
         GB2GC
-        ""
-        "TARGET;INPUT;OUTPUT;WORKING_DIRECTORY;TITLE;WIDTH;HEIGHT;LEGEND;TYPE;XAXIS;YAXIS;FILTER"
-        "SELECT"
+        "SNAPSHOT;DASHBOARD"
+        "TARGET;OUTPUT;WORKING_DIRECTORY;TITLE;WIDTH;HEIGHT;LEGEND;TYPE;XAXIS;YAXIS;MANIFEST"
+        "INPUT;SELECT;FILTER"
         ${ARGN}
     )
 
@@ -206,20 +239,34 @@ function(gb2gc_add_benchmark_chart)
     if (NOT GB2GC_WORKING_DIRECTORY)
       set(GB2GC_WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
     endif()
-    if (NOT GB2GC_TARGET)
+    if (NOT GB2GC_TARGET AND NOT GB2GC_MANIFEST)
         message(FATAL_ERROR "ERROR: Missing required option 'TARGET'")
     endif()
 
     ###########################################################################
     # Assert HTML/chart (CHART prefixed) options
 
-    if (NOT GB2GC_OUTPUT)
-        # Default to same filename as BM_OUT but .html extension
+    if (NOT GB2GC_OUTPUT AND GB2GC_INPUT)
+        # Default to same filename as first input but .html extension
+        list(GET GB2GC_INPUT 0 GB2GC_FIRST_INPUT)
         get_filename_component(GB2GC_OUTPUT_NAME_WE 
-             ${GB2GC_INPUT} NAME_WE)
+             ${GB2GC_FIRST_INPUT} NAME_WE)
         set(GB2GC_OUTPUT "${GB2GC_OUTPUT_NAME_WE}.html")
     endif()
 
+    if (GB2GC_MANIFEST)
+        # All charts of a manifest are generated from a single directory
+        set(GB2GC_ABSOLUTE_INPUT)
+        foreach(GB2GC_PATH ${GB2GC_INPUT})
+            get_filename_component(GB2GC_PATH "${GB2GC_PATH}" 
+                ABSOLUTE BASE_DIR "${GB2GC_WORKING_DIRECTORY}")
+            list(APPEND GB2GC_ABSOLUTE_INPUT "${GB2GC_PATH}")
+        endforeach()
+        set(GB2GC_INPUT ${GB2GC_ABSOLUTE_INPUT})
+        get_filename_component(GB2GC_OUTPUT "${GB2GC_OUTPUT}" 
+            ABSOLUTE BASE_DIR "${GB2GC_WORKING_DIRECTORY}")
+    endif()
+
     #if (NOT GB2GC_ARGS)
     #  list(APPEND GB2GC_ARGS "-c" "bar")
     #  list(APPEND GB2GC_ARGS "-i" "${GB2GC_INPUT}")
@@ -231,7 +278,7 @@ function(gb2gc_add_benchmark_chart)
     if (NOT GB2GC_INPUT)
         message(FATAL_ERROR "ERROR: Missing required option 'INPUT'")
     else()
-        list(APPEND GB2GC_ARGS "-i" "${GB2GC_INPUT}")
+        list(APPEND GB2GC_ARGS "-i" ${GB2GC_INPUT})
     endif()
 
     if (GB2GC_TITLE)
@@ -259,11 +306,33 @@ function(gb2gc_add_benchmark_chart)
         list(APPEND GB2GC_ARGS "-y" "${GB2GC_YAXIS}")
     endif()
     if (GB2GC_FILTER)
-        list(APPEND GB2GC_ARGS "-f" "${GB2GC_FILTER}")
+        list(APPEND GB2GC_ARGS "-f" ${GB2GC_FILTER})
     endif()
     if (GB2GC_SELECT)
         list(APPEND GB2GC_ARGS "-s" "${GB2GC_SELECT}")
     endif()
+    if (GB2GC_SNAPSHOT)
+        list(APPEND GB2GC_ARGS "--snapshot")
+    endif()
+    if (GB2GC_DASHBOARD)
+        list(APPEND GB2GC_ARGS "--dashboard")
+    endif()
+
+    ###########################################################################
+    # Manifest: record chart to be generated by gb2gc_add_chart_manifest
+
+    if (GB2GC_MANIFEST)
+        get_filename_component(GB2GC_MANIFEST "${GB2GC_MANIFEST}" 
+            ABSOLUTE BASE_DIR "${CMAKE_CURRENT_BINARY_DIR}")
+        gb2gc_json_array(GB2GC_JSON_ARGS ${GB2GC_ARGS})
+        set_property(GLOBAL APPEND PROPERTY 
+            "GB2GC_MANIFEST_CHARTS:${GB2GC_MANIFEST}" "{ \"args\": ${GB2GC_JSON_ARGS} }")
+        set_property(GLOBAL APPEND PROPERTY 
+            "GB2GC_MANIFEST_INPUTS:${GB2GC_MANIFEST}" ${GB2GC_INPUT})
+        set_property(GLOBAL APPEND PROPERTY 
+            "GB2GC_MANIFEST_OUTPUTS:${GB2GC_MANIFEST}" "${GB2GC_OUTPUT}")
+        return()
+    endif()
 
     ###########################################################################
     # Custom commands
@@ -290,4 +359,111 @@ function(gb2gc_add_benchmark_chart)
 	    VERBATIM
     )
 
-endfunction()
\ No newline at end of file
+endfunction()
+
+# gb2gc_json_array
+#
+# Formats the given arguments as a JSON array of strings into variable OUT.
+#
+function(gb2gc_json_array OUT)
+    set(GB2GC_ITEMS)
+    foreach(GB2GC_ITEM ${ARGN})
+        string(REPLACE "\\" "\\\\" GB2GC_ITEM "${GB2GC_ITEM}")
+        string(REPLACE "\"" "\\\"" GB2GC_ITEM "${GB2GC_ITEM}")
+        list(APPEND GB2GC_ITEMS "\"${GB2GC_ITEM}\"")
+    endforeach()
+    string(REPLACE ";" ", " GB2GC_ITEMS "${GB2GC_ITEMS}")
+    set(${OUT} "[ ${GB2GC_ITEMS} ]" PARENT_SCOPE)
+endfunction()
+
+# gb2gc_add_chart_manifest
+#
+# Adds a target that generates all charts added to a manifest by 
+# gb2gc_add_benchmark_chart(... MANIFEST manifest) in a single invocation
+# of gb2gc:
+#
+# gb2gc_add_chart_manifest(
+#   TARGET target
+#   MANIFEST manifest
+# )
+#
+# Must be called after all charts have been added to the manifest. 
+#
+# The options are:
+#
+# MANIFEST
+#   Specifies the JSON manifest file to be written at configure time, listing
+#   all charts with their inputs and options. If the path is a relative path 
+#   it will be interpreted as relative to the build tree current binary 
+#   directory. The file is only rewritten when its content changes.
+#   gb2gc parses each distinct input of the manifest once and renders all 
+#   charts concurrently.
+#   Forwards '--manifest <manifest>' to gb2gc.
+#
+# TARGET
+#   Specifies the name of the custom target to be added.
+#
+#
+function(gb2gc_add_chart_manifest)
+    cmake_parse_arguments(
+        GB2GC
+        ""
+        "TARGET;MANIFEST"
+        ""
+        ${ARGN}
+    )
+
+    ###########################################################################
+    # Assert options
+
+    if (NOT GB2GC_TARGET)
+        message(FATAL_ERROR "ERROR: Missing required option 'TARGET'")
+    endif()
+    if (NOT GB2GC_MANIFEST)
+        message(FATAL_ERROR "ERROR: Missing required option 'MANIFEST'")
+    endif()
+    get_filename_component(GB2GC_MANIFEST "${GB2GC_MANIFEST}" 
+        ABSOLUTE BASE_DIR "${CMAKE_CURRENT_BINARY_DIR}")
+
+    get_property(GB2GC_CHARTS GLOBAL PROPERTY "GB2GC_MANIFEST_CHARTS:${GB2GC_MANIFEST}")
+    get_property(GB2GC_INPUTS GLOBAL PROPERTY "GB2GC_MANIFEST_INPUTS:${GB2GC_MANIFEST}")
+    get_property(GB2GC_OUTPUTS GLOBAL PROPERTY "GB2GC_MANIFEST_OUTPUTS:${GB2GC_MANIFEST}")
+    if (NOT GB2GC_CHARTS)
+        message(FATAL_ERROR "ERROR: No charts added to manifest '${GB2GC_MANIFEST}'")
+    endif()
+    list(REMOVE_DUPLICATES GB2GC_INPUTS)
+
+    ###########################################################################
+    # Write manifest, via a temporary file to keep the manifest timestamp 
+    # unless its content changes
+
+    string(REPLACE ";" ",\n    " GB2GC_CHARTS "${GB2GC_CHARTS}")
+    file(WRITE "${GB2GC_MANIFEST}.tmp" "{ \"charts\": [\n    ${GB2GC_CHARTS}\n] }\n")
+    configure_file("${GB2GC_MANIFEST}.tmp" "${GB2GC_MANIFEST}" COPYONLY)
+
+    ###########################################################################
+    # Custom commands
+
+    # Add a custom command to generate all charts of the manifest
+    add_custom_command(
+        OUTPUT ${GB2GC_OUTPUTS}
+        COMMAND $<TARGET_FILE:gb2gc> --manifest "${GB2GC_MANIFEST}"
+        DEPENDS 
+            gb2gc 
+            "${GB2GC_MANIFEST}"
+            ${GB2GC_INPUTS}
+        VERBATIM
+    )
+
+    ###########################################################################
+    # Custom targets
+
+    # Add target to generate all charts
+    add_custom_target(${GB2GC_TARGET}
+        COMMENT "Generating charts of ${GB2GC_MANIFEST}..."
+        COMMAND ${CMAKE_COMMAND} -E echo "Generating charts..."
+        DEPENDS ${GB2GC_OUTPUTS}
+        VERBATIM
+    )
+
+endfunction()
@@ -0,0 +1,131 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "aggregate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "stats_kernels.h"
+
+namespace
+{
+   double mean(const std::vector<double>& values) noexcept
+   {
+      const auto& kernels = gb2gc::get_stats_kernels();
+      return kernels.sum(values.data(), values.size()) / static_cast<double>(values.size());
+   }
+
+   double stddev(const std::vector<double>& values) noexcept
+   {
+      if (values.size() < 2)
+         return 0.0;
+      const auto& kernels = gb2gc::get_stats_kernels();
+      const auto sum = kernels.sum_squared_deviations(values.data(), values.size(), mean(values));
+      return std::sqrt(sum / static_cast<double>(values.size() - 1));
+   }
+
+   // Linearly interpolated percentile p in [0, 100] of the given values
+   double percentile(std::vector<double>& values, double p)
+   {
+      const auto rank = p / 100.0 * static_cast<double>(values.size() - 1);
+      const auto lower = static_cast<std::size_t>(rank);
+      const auto first = values.begin();
+      std::nth_element(first, first + static_cast<std::ptrdiff_t>(lower), values.end());
+      const auto lower_value = values[lower];
+      if (lower + 1 >= values.size())
+         return lower_value;
+      const auto upper_value = *std::min_element(
+         first + static_cast<std::ptrdiff_t>(lower + 1), values.end());
+      return lower_value + (rank - static_cast<double>(lower)) * (upper_value - lower_value);
+   }
+}
+
+gb2gc::aggregate::aggregate() noexcept
+   : kind_(function::first), percentile_(0.0)
+{ }
+
+gb2gc::aggregate::aggregate(const std::string& name)
+   : kind_(function::first), percentile_(0.0), name_(name)
+{
+   if (name == "mean")
+      kind_ = function::mean;
+   else if (name == "median")
+   {
+      kind_ = function::median;
+      percentile_ = 50.0;
+   }
+   else if (name == "min")
+      kind_ = function::min;
+   else if (name == "max")
+      kind_ = function::max;
+   else if (name == "stddev")
+      kind_ = function::stddev;
+   else if (name == "cv")
+      kind_ = function::cv;
+   else if (name.size() > 1 && name[0] == 'p')
+   {
+      auto parsed = std::size_t(0);
+      try
+      {
+         percentile_ = std::stod(name.substr(1), &parsed);
+      }
+      catch (const std::exception&)
+      {
+         parsed = 0;
+      }
+      if (parsed != name.size() - 1 || !(percentile_ >= 0.0 && percentile_ <= 100.0))
+         throw std::invalid_argument("Invalid percentile aggregate: '" + name + "'");
+      kind_ = function::percentile;
+   }
+   else
+   {
+      throw std::invalid_argument("Invalid aggregate: '" + name + "'");
+   }
+}
+
+gb2gc::aggregate::function gb2gc::aggregate::kind() const noexcept
+{
+   return kind_;
+}
+
+double gb2gc::aggregate::percentile() const noexcept
+{
+   return percentile_;
+}
+
+const std::string& gb2gc::aggregate::name() const noexcept
+{
+   return name_;
+}
+
+double gb2gc::aggregate::operator()(std::vector<double>& values) const
+{
+   if (values.empty())
+      throw std::invalid_argument("Aggregate of empty set of values");
+
+   switch (kind_)
+   {
+   case function::mean:
+      return mean(values);
+   case function::median:
+   case function::percentile:
+      return ::percentile(values, percentile_);
+   case function::min:
+      return get_stats_kernels().minimum(values.data(), values.size());
+   case function::max:
+      return get_stats_kernels().maximum(values.data(), values.size());
+   case function::stddev:
+      return stddev(values);
+   case function::cv:
+   {
+      const auto m = mean(values);
+      return m != 0.0 ? stddev(values) / m : 0.0;
+   }
+   case function::first:
+   default:
+      return values.front();
+   }
+}
@@ -0,0 +1,58 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_AGGREGATE_H
+#define GB2GC_AGGREGATE_H
+
+#include <string>
+#include <vector>
+
+namespace gb2gc
+{
+   // Statistic computed over the values of repeated benchmarks, e.g. from
+   // --benchmark_repetitions, sharing the same series and key value.
+   class aggregate final
+   {
+   public:
+      enum class function
+      {
+         first,      // value of first benchmark
+         mean,
+         median,
+         min,
+         max,
+         stddev,     // sample standard deviation
+         cv,         // coefficient of variation, i.e. stddev / mean
+         percentile
+      };
+
+      // Constructs an aggregate selecting the value of the first benchmark
+      aggregate() noexcept;
+
+      // Constructs an aggregate from its name, one of 'mean', 'median', 'min',
+      // 'max', 'stddev', 'cv' or 'p<N>' where N is a percentile in [0, 100].
+      // Throws std::invalid_argument if the name is not valid.
+      explicit aggregate(const std::string& name);
+
+      function kind() const noexcept;
+      double percentile() const noexcept;
+      const std::string& name() const noexcept;
+
+      // Returns the aggregate of the given non-empty values, which may be
+      // reordered.
+      double operator()(std::vector<double>& values) const;
+
+   private:
+      function    kind_;
+      double      percentile_;
+      std::string name_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_AGGREGATE_H
@@ -0,0 +1,119 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "benchmark_table.h"
+
+#include <algorithm>
+
+constexpr std::size_t gb2gc::benchmark_table::npos;
+
+// json_benchmark_table
+
+gb2gc::json_benchmark_table::json_benchmark_table(const nlohmann::json& benchmarks)
+   : benchmarks_(benchmarks)
+{ }
+
+std::size_t gb2gc::json_benchmark_table::size() const
+{
+   return benchmarks_.size();
+}
+
+std::size_t gb2gc::json_benchmark_table::field(const std::string& name) const
+{
+   const auto found = std::find(fields_.begin(), fields_.end(), name);
+   if (found != fields_.end())
+      return static_cast<std::size_t>(found - fields_.begin());
+   fields_.emplace_back(name);
+   return fields_.size() - 1u;
+}
+
+gb2gc::field_value
+gb2gc::json_benchmark_table::value(std::size_t field, std::size_t index) const
+{
+   field_value result;
+   const auto& bm = benchmarks_[index];
+   const auto found = bm.find(fields_[field]);
+   if (found == bm.end())
+      return result;
+
+   const auto& value = *found;
+   if (value.is_string())
+   {
+      const auto& s = value.get_ref<const std::string&>();
+      result.type = field_value::kind::string;
+      result.data = s.data();
+      result.size = s.size();
+   }
+   else if (value.is_boolean())
+   {
+      result.type = field_value::kind::boolean;
+      result.number = value.get<bool>() ? 1.0 : 0.0;
+   }
+   else if (value.is_number())
+   {
+      result.type = field_value::kind::number;
+      result.number = value.get<double>();
+   }
+   return result;
+}
+
+// merged_benchmark_table
+
+gb2gc::merged_benchmark_table::merged_benchmark_table(
+   std::vector<const benchmark_table*> tables, std::vector<std::string> files)
+   : tables_(std::move(tables))
+   , files_(std::move(files))
+   , offsets_(1, 0)
+{
+   for (const auto table : tables_)
+      offsets_.emplace_back(offsets_.back() + table->size());
+
+   // The first field is the input file of each benchmark
+   fields_.emplace_back(merged_field{ "input_file", std::vector<std::size_t>() });
+}
+
+std::size_t gb2gc::merged_benchmark_table::size() const
+{
+   return offsets_.back();
+}
+
+std::size_t gb2gc::merged_benchmark_table::field(const std::string& name) const
+{
+   const auto found = std::find_if(fields_.begin(), fields_.end(),
+      [&](const merged_field& f) { return f.name == name; });
+   if (found != fields_.end())
+      return static_cast<std::size_t>(found - fields_.begin());
+
+   merged_field f{ name, std::vector<std::size_t>() };
+   auto any = false;
+   for (const auto table : tables_)
+   {
+      f.fields.emplace_back(table->field(name));
+      any = any || f.fields.back() != npos;
+   }
+   if (!any)
+      return npos;
+   fields_.emplace_back(std::move(f));
+   return fields_.size() - 1u;
+}
+
+gb2gc::field_value
+gb2gc::merged_benchmark_table::value(std::size_t field, std::size_t index) const
+{
+   const auto table = static_cast<std::size_t>(
+      std::upper_bound(offsets_.begin(), offsets_.end(), index) - offsets_.begin()) - 1u;
+   field_value result;
+   if (field == 0)
+   {
+      result.type = field_value::kind::string;
+      result.data = files_[table].data();
+      result.size = files_[table].size();
+      return result;
+   }
+
+   const auto f = fields_[field].fields[table];
+   if (f == npos)
+      return result;
+   return tables_[table]->value(f, index - offsets_[table]);
+}
@@ -0,0 +1,107 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_BENCHMARK_TABLE_H
+#define GB2GC_BENCHMARK_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace gb2gc
+{
+   // Value of a benchmark field read from a benchmark_table. Strings refer to
+   // characters owned by the table.
+   struct field_value
+   {
+      enum class kind : std::uint8_t
+      {
+         missing = 0, // field absent, null or nested
+         boolean = 1,
+         number  = 2,
+         string  = 3
+      };
+
+      kind        type = kind::missing;
+      double      number = 0.0;   // valid for boolean and number
+      const char* data = nullptr; // valid for string
+      std::size_t size = 0;       // valid for string
+   };
+
+   // Read-only access to the fields of a sequence of benchmarks. Fields are
+   // resolved to an index once and values are then read by field index and
+   // benchmark index, which allows building data sets directly from the typed
+   // columns of a snapshot without reconstructing JSON benchmarks.
+   class benchmark_table
+   {
+   public:
+      static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+      virtual ~benchmark_table() = default;
+
+      // Returns the number of benchmarks
+      virtual std::size_t size() const = 0;
+
+      // Returns the index of the given field or npos if no benchmark has it.
+      // Tables unaware of which fields exist may return an index regardless.
+      virtual std::size_t field(const std::string& name) const = 0;
+
+      // Returns the value of the given field of the benchmark at the given
+      // index. The field must have been returned by field().
+      virtual field_value value(std::size_t field, std::size_t index) const = 0;
+   };
+
+   // benchmark_table over a JSON array of benchmarks. Since JSON benchmarks
+   // have no common set of fields, fields are registered when resolved which
+   // makes resolving fields not thread-safe.
+   class json_benchmark_table final : public benchmark_table
+   {
+   public:
+      explicit json_benchmark_table(const nlohmann::json& benchmarks);
+
+      std::size_t size() const override;
+      std::size_t field(const std::string& name) const override;
+      field_value value(std::size_t field, std::size_t index) const override;
+
+   private:
+      const nlohmann::json&            benchmarks_;
+      mutable std::vector<std::string> fields_;
+   };
+
+   // benchmark_table merging the given tables in the given order. Each
+   // benchmark is tagged with the path of the file its table was read from in
+   // the 'input_file' field. Resolving fields is not thread-safe.
+   class merged_benchmark_table final : public benchmark_table
+   {
+   public:
+      merged_benchmark_table(std::vector<const benchmark_table*> tables,
+         std::vector<std::string> files);
+
+      std::size_t size() const override;
+      std::size_t field(const std::string& name) const override;
+      field_value value(std::size_t field, std::size_t index) const override;
+
+   private:
+      struct merged_field
+      {
+         std::string              name;
+         std::vector<std::size_t> fields; // field index in each table
+      };
+
+      std::vector<const benchmark_table*> tables_;
+      std::vector<std::string>            files_;
+      std::vector<std::size_t>            offsets_; // first benchmark of each table
+      mutable std::vector<merged_field>   fields_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_BENCHMARK_TABLE_H
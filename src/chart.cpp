@@ -4,6 +4,121 @@
 
 #include "chart.h"
 
+#include <stdexcept>
+
+namespace
+{
+    // Returns the given string escaped for a single-quoted JavaScript string
+    // literal embedded in a HTML script element
+    std::string escape_js(const char* s, size_t n)
+    {
+        std::string escaped;
+        escaped.reserve(n);
+        for (auto i = size_t(0); i < n; ++i)
+        {
+            switch (s[i])
+            {
+            case '\\': escaped += "\\\\"; break;
+            case '\'': escaped += "\\'"; break;
+            case '\n':  escaped += "\\n"; break;
+            case '\r':  escaped += "\\r"; break;
+            case '/':
+                // Prevent closing the script element
+                if (i > 0 && s[i - 1] == '<')
+                    escaped += '\\';
+                escaped += '/';
+                break;
+            default:   escaped += s[i]; break;
+            }
+        }
+        return escaped;
+    }
+
+    std::string escape_js(const std::string& s)
+    {
+        return escape_js(s.data(), s.size());
+    }
+
+    void write_value(gb2gc::output_sink& sink, const gb2gc::variant& value)
+    {
+        switch (value.index())
+        {
+        case 0:
+            sink << "null";
+            break;
+        case 12:
+            sink << '\'' << escape_js(nonstd::get<12>(value)) << '\'';
+            break;
+        default:
+            char number[gb2gc::max_number_chars];
+            sink.append(number, static_cast<size_t>(
+                gb2gc::format_number(number, value) - number));
+            break;
+        }
+    }
+
+    // Returns true if the given column of the view holds strings, columns
+    // holding only numbers or nulls are number columns
+    bool is_string_column(const gb2gc::data_set_view& view, size_t col)
+    {
+        using storage = gb2gc::data_set::column_type::storage;
+        const auto& column = view.get_col(col);
+        switch (column.storage_type())
+        {
+        case storage::string:
+            return true;
+        case storage::mixed:
+            for (auto row = size_t(0); row < view.rows(); ++row)
+            {
+                if (column[view.row_index(row)].index() == 12)
+                    return true;
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+
+    const char* name(gb2gc::googlechart_options::position pos) noexcept
+    {
+        using position = gb2gc::googlechart_options::position;
+        switch (pos)
+        {
+        case position::left:   return "left";
+        case position::right:  return "right";
+        case position::top:    return "top";
+        case position::bottom: return "bottom";
+        case position::none:
+        default:               return "none";
+        }
+    }
+
+    const char* name(gb2gc::googlechart_options::curve curve) noexcept
+    {
+        using curve_type = gb2gc::googlechart_options::curve;
+        switch (curve)
+        {
+        case curve_type::function: return "function";
+        case curve_type::none:
+        default:                   return "none";
+        }
+    }
+
+    const char* name(gb2gc::googlechart::visualization type)
+    {
+        using visualization = gb2gc::googlechart::visualization;
+        switch (type)
+        {
+        case visualization::scatter:   return "ScatterChart";
+        case visualization::line:      return "LineChart";
+        case visualization::histogram: return "Histogram";
+        case visualization::bar:       return "BarChart";
+        default:
+            throw std::invalid_argument("invalid Google Chart visualization type");
+        }
+    }
+}
+
 std::ostream& gb2gc::operator<<(std::ostream& os, const color& color)
 {  // format color as #rrggbb
    os << '#' << std::hex << color.r << color.g << color.b;
@@ -13,173 +128,386 @@ std::ostream& gb2gc::operator<<(std::ostream& os, const color& color)
 std::ostream&
 gb2gc::operator<<(std::ostream& os, gb2gc::googlechart_options::position pos)
 {
-    switch (pos)
-    {
-    case googlechart_options::position::left:
-        os << "left";
-        break;
-    case googlechart_options::position::right:
-        os << "right";
-        break;
-    case googlechart_options::position::top:
-        os << "top";
-        break;
-    case googlechart_options::position::bottom:
-        os << "bottom";
-        break;
-    case googlechart_options::position::none:
-    default:
-        os << "none";
-        break;
-    }
-    return os;
+    return os << name(pos);
 }
 
 std::ostream&
 gb2gc::operator<<(std::ostream& os, googlechart_options::curve curve)
 {
-    switch (curve)
-    {
-    case googlechart_options::curve::function:
-        os << "function";
-        break;
-    case googlechart_options::curve::none:
-    default:
-        os << "none";
-        break;
-    }
-    return os;
+    return os << name(curve);
 }
 
 std::ostream&
 gb2gc::operator<<(std::ostream& os, googlechart::visualization type)
 {
-    switch (type)
-    {
-    case googlechart::visualization::scatter:
-        os << "ScatterChart";
-        break;
-    case googlechart::visualization::line:
-        os << "LineChart";
-        break;
-    case googlechart::visualization::histogram:
-        os << "Histogram";
-        break;
-    case googlechart::visualization::bar:
-        os << "BarChart";
-        break;
-    default:
-        throw std::invalid_argument("invalid Google Chart visualization type");
-    }
-    return os;
+    return os << name(type);
+}
+
+gb2gc::output_sink&
+gb2gc::operator<<(output_sink& sink, googlechart_options::position pos)
+{
+    return sink << name(pos);
+}
+
+gb2gc::output_sink&
+gb2gc::operator<<(output_sink& sink, googlechart_options::curve curve)
+{
+    return sink << name(curve);
 }
 
-void gb2gc::detail::write_axis(std::ostream& os, const format& /*fmt*/, 
+gb2gc::output_sink&
+gb2gc::operator<<(output_sink& sink, googlechart::visualization type)
+{
+    return sink << name(type);
+}
+
+void gb2gc::detail::write_axis(std::ostream& os, const format& fmt,
+   size_t level, const axis& axis)
+{
+    output_sink sink(os);
+    write_axis(sink, fmt, level, axis);
+    sink.flush();
+}
+
+void gb2gc::detail::write_axis(output_sink& sink, const format& /*fmt*/,
    size_t /*level*/, const axis& axis)
 {
-    os << "{";
+    sink << "{";
     bool write = false;
     if (!axis.title.empty())
     {
-        if (write) os << ',';
-        os << " title: '" << axis.title << '\'';
+        if (write) sink << ',';
+        sink << " title: '" << axis.title << '\'';
         write = true;
     }
     if (axis.min_value.index() != 0)
     {
-        if (write) os << ',';
-        os << " minValue: " << axis.min_value;
+        if (write) sink << ',';
+        sink << " minValue: ";
+        write_value(sink, axis.min_value);
         write = true;
     }
     if (axis.max_value.index() != 0)
     {
-        if (write) os << ',';
-        os << " maxValue: " << axis.max_value;
+        if (write) sink << ',';
+        sink << " maxValue: ";
+        write_value(sink, axis.max_value);
         write = true;
     }
-    os << " }";
+    sink << " }";
 }
 
-void gb2gc::detail::write_options(std::ostream& os, const format& fmt, 
-   size_t level, const googlechart_options& opt)
+void gb2gc::detail::write_options(std::ostream& os, const format& fmt,
+   size_t level, const googlechart_options& opt, const char* name)
+{
+    output_sink sink(os);
+    write_options(sink, fmt, level, opt, name);
+    sink.flush();
+}
+
+void gb2gc::detail::write_options(output_sink& sink, const format& fmt, 
+   size_t level, const googlechart_options& opt, const char* name)
 {
     const indent ind{ fmt, level };
     const indent ind_opt{ fmt, level + 1 };
-    os << ind << "var options = {\n";
-    os << ind_opt << "hAxis: ";
-    write_axis(os, fmt, level, opt.horizontal_axis);
-    os << ",\n";
-    os << ind_opt << "vAxis: ";
-    write_axis(os, fmt, level, opt.vertical_axis);
-    os << ",\n";
+    const auto nl = fmt.line_break();
+    sink << ind << "var " << name << " = {" << nl;
+    sink << ind_opt << "hAxis: ";
+    write_axis(sink, fmt, level, opt.horizontal_axis);
+    sink << ',' << nl;
+    sink << ind_opt << "vAxis: ";
+    write_axis(sink, fmt, level, opt.vertical_axis);
+    sink << ',' << nl;
     if (!opt.title.empty())
-        os << ind_opt << "title: '" << opt.title << "',\n";
-    os << ind_opt << "legend: { position: '" << opt.legend << "' },\n";
+        sink << ind_opt << "title: '" << opt.title << "'," << nl;
+    sink << ind_opt << "legend: { position: '" << opt.legend << "' }," << nl;
     if (!opt.colors.empty())
-        os << ind_opt << "colors: [ '#01beff', '#3af2a2' ],\n";
+        sink << ind_opt << "colors: [ '#01beff', '#3af2a2' ]," << nl;
     if (opt.curve_type != googlechart_options::curve::none)
-        os << ind_opt << "curveType: '" << opt.curve_type << "',\n";
+        sink << ind_opt << "curveType: '" << opt.curve_type << "'," << nl;
     if (!opt.font_name.empty())
-        os << ind_opt << "fontName: '" << opt.font_name << "',\n";
+        sink << ind_opt << "fontName: '" << opt.font_name << "'," << nl;
     if (opt.data_opacity != 1.0f)
-        os << ind_opt << "dataOpacity: " << opt.data_opacity << ",\n";
+        sink << ind_opt << "dataOpacity: " << opt.data_opacity << "," << nl;
     if (opt.interpolate_nulls)
-        os << ind_opt << "interpolateNulls: " << opt.interpolate_nulls << ",\n";
+        sink << ind_opt << "interpolateNulls: " << opt.interpolate_nulls << "," << nl;
     if (opt.point_size != 0.0f)
-        os << ind_opt << "pointSize: " << opt.point_size << ",\n";
-    os << ind << "};\n";
+        sink << ind_opt << "pointSize: " << opt.point_size << "," << nl;
+    sink << ind << "};" << nl;
 }
 
 void gb2gc::detail::write_data_set(std::ostream& os, const format& fmt,
    size_t level, const data_set& ds)
+{
+    write_data_set(os, fmt, level, data_set_view(ds));
+}
+
+void gb2gc::detail::write_data_set(std::ostream& os, const format& fmt,
+   size_t level, const data_set_view& view)
+{
+    output_sink sink(os);
+    write_data_set(sink, fmt, level, view);
+    sink.flush();
+}
+
+void gb2gc::detail::write_data_set(output_sink& sink, const format& fmt,
+   size_t level, const data_set& ds)
+{
+    write_data_set(sink, fmt, level, data_set_view(ds));
+}
+
+void gb2gc::detail::write_data_set(output_sink& sink, const format& fmt,
+   size_t level, const data_set_view& view)
 {
     const indent ind{ fmt, level };
     const indent ind_label{ fmt, level + 1 };
-    os << ind << "var data = google.visualization.arrayToDataTable([\n";
-    os << ind_label << '[';
-
-    {	// format series
-        auto it = ds.col_begin();
-        if (it != ds.col_end())
-            os << '\'' << it->name() << '\'';
-        while (++it != ds.col_end())
-            os << ", '" << it->name() << '\'';
-        os << "],\n";
+    const indent ind_row{ fmt, level + 2 };
+    const auto nl = fmt.line_break();
+    const auto rows = view.rows();
+    const auto cols = view.cols();
+    sink << ind << "var data = new google.visualization.DataTable({" << nl;
+
+    // Columns are typed from the data set so that the client need not infer
+    // column types by scanning rows
+    std::vector<bool> is_string(cols);
+    {	// format columns
+        sink << ind_label << (fmt.compact ? "cols:[" : "cols: [");
+        for (auto col = size_t(0); col < cols; ++col)
+        {
+            if (col != 0)
+                sink << (fmt.compact ? "," : ", ");
+            is_string[col] = is_string_column(view, col);
+            sink << "{label:'" << escape_js(view.get_col(col).name())
+                << "',type:'" << (is_string[col] ? "string" : "number") << "'}";
+        }
+        sink << "]," << nl;
     }
 
-    {	// format values
-        for (auto it = ds.row_begin(); it != ds.row_end(); )
+    {	// format rows, each distinct pooled string is only escaped once and
+        // numbers are formatted directly from typed columns into the sink.
+        using storage = data_set::column_type::storage;
+        const auto& strings = view.strings();
+        std::vector<std::string> escaped(strings.count());
+        std::vector<bool> is_escaped(strings.count(), false);
+
+        char number[max_number_chars];
+        sink << ind_label << (fmt.compact ? "rows:[" : "rows: [") << nl;
+        for (auto row = size_t(0); row < rows; ++row)
         {
-            os << ind_label << it;
-            if (++it == ds.row_end())
-            break;
-            os << ",\n";
+            const auto index = view.row_index(row);
+            sink << ind_row << "{c:[";
+            for (auto col = size_t(0); col < cols; ++col)
+            {
+                if (col != 0)
+                    sink << ',';
+                const auto& column = view.get_col(col);
+                const auto type = column.storage_type();
+                if (column.is_null(index))
+                {
+                    sink << "null";
+                    continue;
+                }
+
+                sink << "{v:";
+                if (type == storage::mixed)
+                {
+                    const auto value = column[index];
+                    if (is_string[col] && value.index() != 12)
+                    {   // numbers in a string column are written as strings
+                        sink << '\'';
+                        write_value(sink, value);
+                        sink << '\'';
+                    }
+                    else
+                    {
+                        write_value(sink, value);
+                    }
+                }
+                else if (type == storage::integer)
+                {
+                    const auto value = column.integer(index);
+                    const auto t = column.type_index();
+                    const auto is_unsigned = t == 2 || t == 4 || t == 6 || t == 8;
+                    const auto last = is_unsigned ?
+                        format_number(number, static_cast<unsigned long long>(value)) :
+                        format_number(number, value);
+                    sink.append(number, static_cast<size_t>(last - number));
+                }
+                else if (type == storage::floating)
+                {
+                    const auto value = column.floating(index);
+                    const auto last = column.type_index() == 9 ?
+                        format_number(number, static_cast<float>(value)) :
+                        format_number(number, value);
+                    sink.append(number, static_cast<size_t>(last - number));
+                }
+                else if (&column.strings() == &strings)
+                {
+                    const auto code = column.code(index);
+                    if (!is_escaped[code])
+                    {
+                        escaped[code] = escape_js(strings.data(code), strings.size(code));
+                        is_escaped[code] = true;
+                    }
+                    sink << '\'' << escaped[code] << '\'';
+                }
+                else
+                {
+                    sink << '\'' << escape_js(column.strings().str(column.code(index))) << '\'';
+                }
+                sink << '}';
+            }
+            sink << "]}";
+            if (row + 1 != rows)
+                sink << ',';
+            sink << nl;
         }
+        sink << ind_label << ']' << nl;
     }
 
-    os << "]);\n";
+    sink << ind << "});" << nl;
 }
 
-void gb2gc::write(std::ostream& os, const format& fmt, size_t level,
+void gb2gc::write(output_sink& sink, const format& fmt, size_t level,
     const googlechart& gc, const data_set& data_set, const std::string& chart_div)
+{
+    write(sink, fmt, level, gc, data_set_view(data_set), chart_div);
+}
+
+void gb2gc::write(output_sink& sink, const format& fmt, size_t level,
+    const googlechart& gc, const data_set_view& view, const std::string& chart_div)
 {
     const indent ind{ fmt, level };
     const indent ind_func{ fmt, level + 1 };
-    os << ind << "google.charts.load(\"current\", {packages:[\"corechart\"]});\n";
-    os << ind << "google.charts.setOnLoadCallback(drawChart);\n";
-    os << ind << "function drawChart() {\n";
-    detail::write_data_set(os, fmt, level + 1, data_set);
-    os << '\n';
-    detail::write_options(os, fmt, level + 1, gc.options);
-    os << '\n';
-    os << ind_func << "var chart = new google.visualization."
+    const auto nl = fmt.line_break();
+    sink << ind << "google.charts.load(\"current\", {packages:[\"corechart\"]});" << nl;
+    sink << ind << "google.charts.setOnLoadCallback(drawChart);" << nl;
+    sink << ind << "function drawChart() {" << nl;
+    detail::write_data_set(sink, fmt, level + 1, view);
+    sink << nl;
+    detail::write_options(sink, fmt, level + 1, gc.options);
+    sink << nl;
+    sink << ind_func << "var chart = new google.visualization."
         << gc.type << "(document.getElementById('"
-        << chart_div << "'));\n";
-    os << ind_func << "chart.draw(data, options);\n";
-    os << ind << "}";
+        << chart_div << "'));" << nl;
+    sink << ind_func << "chart.draw(data, options);" << nl;
+    sink << ind << "}";
+}
+
+void gb2gc::write(output_sink& sink, const format& fmt, size_t level,
+    const googlechart_dashboard& dashboard, const data_set_view& table)
+{
+    const indent ind{ fmt, level };
+    const indent ind_func{ fmt, level + 1 };
+    const auto nl = fmt.line_break();
+    sink << ind << "google.charts.load(\"current\", {packages:[\"corechart\"]});" << nl;
+    sink << ind << "google.charts.setOnLoadCallback(drawCharts);" << nl;
+    sink << ind << "function drawCharts() {" << nl;
+    detail::write_data_set(sink, fmt, level + 1, table);
+
+    const auto write_indices = [&](const std::vector<size_t>& indices)
+    {
+        sink << '[';
+        for (auto i = size_t(0); i < indices.size(); ++i)
+        {
+            if (i != 0)
+                sink << ',';
+            sink << indices[i];
+        }
+        sink << ']';
+    };
+
+    std::string options_name;
+    for (auto i = size_t(0); i < dashboard.charts.size(); ++i)
+    {
+        const auto& chart = dashboard.charts[i];
+        sink << nl;
+        sink << ind_func << "var view" << i
+            << " = new google.visualization.DataView(data);" << nl;
+        if (!chart.columns.empty())
+        {
+            sink << ind_func << "view" << i << ".setColumns(";
+            write_indices(chart.columns);
+            sink << ");" << nl;
+        }
+        if (!chart.rows.empty())
+        {
+            sink << ind_func << "view" << i << ".setRows(";
+            write_indices(chart.rows);
+            sink << ");" << nl;
+        }
+        options_name = "options" + std::to_string(i);
+        detail::write_options(sink, fmt, level + 1, chart.gc.options, options_name.c_str());
+        sink << ind_func << "new google.visualization." << chart.gc.type
+            << "(document.getElementById('" << chart.dom_options.div
+            << "')).draw(view" << i << ", " << options_name << ");" << nl;
+    }
+    sink << ind << "}";
+}
+
+void gb2gc::googlechart_dashboard::write_html(output_sink& sink,
+    const data_set_view& table, const googlechart_dom_options& dom_options) const
+{
+    const auto html_fmt = dom_options.compact ? format::minified() : format();
+    html_writer html(sink, html_fmt);
+    html.open("html");
+
+    html.open("head");
+    if (dom_options.include_meta_timestamp)
+    {
+        html.open("meta")
+            .attr("name", "timestamp")
+            .attr("timestamp", detail::local_date_time())
+            .close();
+    }
+    html.open("script")
+        .attr("type", "text/javascript")
+        .attr("src", "https://www.gstatic.com/charts/loader.js")
+        .close();
+    html.open("script")
+        .attr("type", "text/javascript")
+        .content([&](output_sink& out, const format& fmt, size_t level)
+        {
+            write(out, fmt, level, *this, table);
+        })
+        .close();
+    html.close();
+
+    html.open("body");
+    for (const auto& chart : charts)
+    {
+        html.comment("This div element will hold a generated chart");
+        html.open("div")
+            .attr("id", chart.dom_options.div)
+            .attr("style", "width: " + std::to_string(chart.dom_options.width) +
+                "px; height: " + std::to_string(chart.dom_options.height) + "px;")
+            .close();
+    }
+    html.close_all();
+}
+
+void gb2gc::googlechart_dashboard::write_html(std::ostream& os,
+    const data_set_view& table, const googlechart_dom_options& dom_options) const
+{
+    output_sink sink(os);
+    write_html(sink, table, dom_options);
+    sink.flush();
+}
+
+void gb2gc::googlechart_dashboard::write_html_file(const char* path,
+    const data_set_view& table, const googlechart_dom_options& dom_options) const
+{
+    auto sink = output_sink::open(path);
+    write_html(sink, table, dom_options);
+    sink.flush();
 }
 
 std::string gb2gc::googlechart::local_date_time() const
+{
+    return detail::local_date_time();
+}
+
+std::string gb2gc::detail::local_date_time()
 {
     time_t now = time(0);
     struct tm tstruct;
@@ -19,6 +19,7 @@
 
 #include "dom.h"
 #include "data_set.h"
+#include "data_set_view.h"
 
 namespace gb2gc
 {
@@ -63,6 +64,7 @@ namespace gb2gc
       unsigned height = default_height;
       std::string div = "chart_div";
       bool include_meta_timestamp = false;
+      bool compact = false;
    };
 
    ////////////////////////////////////////////////////////////////////////////
@@ -102,12 +104,22 @@ namespace gb2gc
 
    std::ostream& operator<<(std::ostream& os, googlechart_options::position pos);
    std::ostream& operator<<(std::ostream& os, googlechart_options::curve curve);
+   output_sink& operator<<(output_sink& sink, googlechart_options::position pos);
+   output_sink& operator<<(output_sink& sink, googlechart_options::curve curve);
 
    namespace detail
    {
+      void write_axis(output_sink& sink, const format& fmt, size_t level, const axis& axis);
       void write_axis(std::ostream& os, const format& fmt, size_t level, const axis& axis);
-      void write_options(std::ostream& os, const format& fmt, size_t level, const googlechart_options& opt);
+      void write_options(output_sink& sink, const format& fmt, size_t level, const googlechart_options& opt,
+         const char* name = "options");
+      void write_options(std::ostream& os, const format& fmt, size_t level, const googlechart_options& opt,
+         const char* name = "options");
+      void write_data_set(output_sink& sink, const format& fmt, size_t level, const data_set& ds);
+      void write_data_set(output_sink& sink, const format& fmt, size_t level, const data_set_view& view);
       void write_data_set(std::ostream& os, const format& fmt, size_t level, const data_set& ds);
+      void write_data_set(std::ostream& os, const format& fmt, size_t level, const data_set_view& view);
+      std::string local_date_time();
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -127,46 +139,64 @@ namespace gb2gc
       googlechart_options options;
       visualization type = visualization::histogram;
 
+      // Writes the chart page directly to the sink without building a DOM
       template<class DataSet>
-      void write_html(std::ostream& os, const DataSet& transformer,
+      void write_html(output_sink& sink, const DataSet& transformer,
          const googlechart_dom_options& dom_options = googlechart_dom_options{})
       {
-         element html("html");
+         const auto html_fmt = dom_options.compact ? format::minified() : format();
+         html_writer html(sink, html_fmt);
+         html.open("html");
 
-         auto& head = html.add_element("head");
+         html.open("head");
          if (dom_options.include_meta_timestamp)
          {
-             head.add_element("meta")
-                 .add_attribute("name", "timestamp")
-                 .add_attribute("timestamp", local_date_time());
+            html.open("meta")
+               .attr("name", "timestamp")
+               .attr("timestamp", local_date_time())
+               .close();
          }
-         head.add_element("script")
-            .add_attribute("type", "text/javascript")
-            .add_attribute("src", "https://www.gstatic.com/charts/loader.js");
-         head.add_element("script")
-            .add_attribute("type", "text/javascript")
-            .set_content(make_convertible(*this, transformer, dom_options.div));
-
-         auto& body = html.add_element("body");
-         body.add_element("div")
-            .set_comment("This div element will hold the generated chart")
-            .add_attribute("id", dom_options.div)
-            .add_attribute("style", "width: " + std::to_string(dom_options.width) +
-               "px; height: " + std::to_string(dom_options.height) + "px;");
-
-         write_dom(os, html);
+         html.open("script")
+            .attr("type", "text/javascript")
+            .attr("src", "https://www.gstatic.com/charts/loader.js")
+            .close();
+         html.open("script")
+            .attr("type", "text/javascript")
+            .content([&](output_sink& out, const format& fmt, size_t level)
+            {
+               write(out, fmt, level, *this, transformer, dom_options.div);
+            })
+            .close();
+         html.close();
+
+         html.open("body");
+         html.comment("This div element will hold the generated chart");
+         html.open("div")
+            .attr("id", dom_options.div)
+            .attr("style", "width: " + std::to_string(dom_options.width) +
+               "px; height: " + std::to_string(dom_options.height) + "px;")
+            .close();
+         html.close_all();
+      }
+
+      template<class DataSet>
+      void write_html(std::ostream& os, const DataSet& transformer,
+         const googlechart_dom_options& dom_options = googlechart_dom_options{})
+      {
+         output_sink sink(os);
+         write_html(sink, transformer, dom_options);
+         sink.flush();
       }
 
+      // Writes the chart to the file at the given path, or to standard output
+      // if the path is '-'
       template<class DataTransformer>
       void write_html_file(const char* path, const DataTransformer& transformer,
          const googlechart_dom_options& dom_options = googlechart_dom_options{})
       {
-         std::ofstream file;
-         file.open(path, std::ios::out);
-         if (!file)
-            throw std::exception();
-         write_html(file, transformer, dom_options);
-         file.close();
+         auto sink = output_sink::open(path);
+         write_html(sink, transformer, dom_options);
+         sink.flush();
       }
 
    private:
@@ -174,17 +204,55 @@ namespace gb2gc
    };
 
    std::ostream& operator<<(std::ostream& os, googlechart::visualization type);
+   output_sink& operator<<(output_sink& sink, googlechart::visualization type);
 
-   void write(std::ostream& os, const format& fmt, size_t level,
+   void write(output_sink& sink, const format& fmt, size_t level,
        const googlechart& gc, const data_set& data_set, const std::string& chart_div);
+   void write(output_sink& sink, const format& fmt, size_t level,
+       const googlechart& gc, const data_set_view& view, const std::string& chart_div);
+
+   ////////////////////////////////////////////////////////////////////////////
+   // googlechart_dashboard
+
+   // Multiple charts written to a single page sharing a single loader and a
+   // single embedded data table. Each chart draws a projection of the columns
+   // and rows of the table through a google.visualization.DataView.
+   class googlechart_dashboard
+   {
+   public:
+      struct chart
+      {
+         googlechart             gc;
+         googlechart_dom_options dom_options; // div and size of the chart
+         std::vector<size_t>     columns;     // projected columns, all if empty
+         std::vector<size_t>     rows;        // projected rows, all if empty
+      };
+
+      std::vector<chart> charts;
+
+      // Writes the page, only the compact and timestamp options of the given
+      // DOM options are used
+      void write_html(output_sink& sink, const data_set_view& table,
+         const googlechart_dom_options& dom_options = googlechart_dom_options{}) const;
+      void write_html(std::ostream& os, const data_set_view& table,
+         const googlechart_dom_options& dom_options = googlechart_dom_options{}) const;
+
+      // Writes the page to the file at the given path, or to standard output
+      // if the path is '-'
+      void write_html_file(const char* path, const data_set_view& table,
+         const googlechart_dom_options& dom_options = googlechart_dom_options{}) const;
+   };
+
+   void write(output_sink& sink, const format& fmt, size_t level,
+       const googlechart_dashboard& dashboard, const data_set_view& table);
 
    template<class DataTransformer>
    static element::convertible make_convertible(
       const googlechart& chart, const DataTransformer& transformer, const std::string& chart_div)
    {
-      return [&](std::ostream& os, const format& fmt, size_t level)
+      return [&](output_sink& sink, const format& fmt, size_t level)
       {
-         write(os, fmt, level, chart, transformer, chart_div);
+         write(sink, fmt, level, chart, transformer, chart_div);
       };
    }
 
@@ -4,6 +4,430 @@
 
 #include "data_set.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "thread_pool.h"
+
+namespace
+{
+    using storage = gb2gc::data_set::column_type::storage;
+
+    storage storage_for(size_t type_index) noexcept
+    {
+        if (type_index == 0)
+            return storage::none;
+        if (type_index <= 8)
+            return storage::integer;
+        if (type_index <= 11)
+            return storage::floating;
+        return storage::string;
+    }
+
+    long long to_integer(const gb2gc::variant& v)
+    {
+        switch (v.index())
+        {
+        case 1:  return nonstd::get<1>(v);
+        case 2:  return nonstd::get<2>(v);
+        case 3:  return nonstd::get<3>(v);
+        case 4:  return nonstd::get<4>(v);
+        case 5:  return nonstd::get<5>(v);
+        case 6:  return static_cast<long long>(nonstd::get<6>(v));
+        case 7:  return nonstd::get<7>(v);
+        case 8:  return static_cast<long long>(nonstd::get<8>(v));
+        default: throw std::invalid_argument("variant is not an integer");
+        }
+    }
+
+    gb2gc::variant from_integer(size_t type_index, long long value)
+    {
+        switch (type_index)
+        {
+        case 1:  return gb2gc::variant(static_cast<short>(value));
+        case 2:  return gb2gc::variant(static_cast<unsigned short>(value));
+        case 3:  return gb2gc::variant(static_cast<int>(value));
+        case 4:  return gb2gc::variant(static_cast<unsigned int>(value));
+        case 5:  return gb2gc::variant(static_cast<long>(value));
+        case 6:  return gb2gc::variant(static_cast<unsigned long>(value));
+        case 7:  return gb2gc::variant(value);
+        case 8:  return gb2gc::variant(static_cast<unsigned long long>(value));
+        default: throw std::invalid_argument("type is not an integer");
+        }
+    }
+
+    double to_floating(const gb2gc::variant& v)
+    {
+        switch (v.index())
+        {
+        case 9:  return nonstd::get<9>(v);
+        case 10: return nonstd::get<10>(v);
+        case 11: return static_cast<double>(nonstd::get<11>(v));
+        default: throw std::invalid_argument("variant is not floating point");
+        }
+    }
+
+    gb2gc::variant from_floating(size_t type_index, double value)
+    {
+        switch (type_index)
+        {
+        case 9:  return gb2gc::variant(static_cast<float>(value));
+        case 10: return gb2gc::variant(value);
+        case 11: return gb2gc::variant(static_cast<long double>(value));
+        default: throw std::invalid_argument("type is not floating point");
+        }
+    }
+
+    bool is_unsigned(size_t type_index) noexcept
+    {
+        return type_index == 2 || type_index == 4 || type_index == 6 || type_index == 8;
+    }
+
+    template<class T>
+    int compare_values(const T& lhs, const T& rhs) noexcept
+    {
+        return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+    }
+
+    int compare_floating(double lhs, double rhs) noexcept
+    {
+        // NaN orders after all other values to keep a strict weak ordering
+        const auto lhs_nan = std::isnan(lhs);
+        const auto rhs_nan = std::isnan(rhs);
+        if (lhs_nan || rhs_nan)
+            return compare_values(lhs_nan, rhs_nan);
+        return compare_values(lhs, rhs);
+    }
+
+    int compare_strings(const char* lhs, size_t lhs_size, 
+        const char* rhs, size_t rhs_size) noexcept
+    {
+        const auto result = std::memcmp(lhs, rhs, (std::min)(lhs_size, rhs_size));
+        return result != 0 ? result : compare_values(lhs_size, rhs_size);
+    }
+
+    // Compares variants of a mixed column, nulls order before numbers
+    // which order before strings
+    int compare_variants(const gb2gc::variant& lhs, const gb2gc::variant& rhs)
+    {
+        const auto lhs_kind = storage_for(lhs.index());
+        const auto rhs_kind = storage_for(rhs.index());
+        const auto lhs_rank = lhs_kind == storage::none ? 0 : (lhs_kind == storage::string ? 2 : 1);
+        const auto rhs_rank = rhs_kind == storage::none ? 0 : (rhs_kind == storage::string ? 2 : 1);
+        if (lhs_rank != rhs_rank || lhs_rank == 0)
+            return compare_values(lhs_rank, rhs_rank);
+        if (lhs_rank == 2)
+        {
+            const auto& l = nonstd::get<12>(lhs);
+            const auto& r = nonstd::get<12>(rhs);
+            return compare_strings(l.data(), l.size(), r.data(), r.size());
+        }
+        if (lhs_kind == storage::integer && rhs_kind == storage::integer)
+        {
+            if (is_unsigned(lhs.index()) && is_unsigned(rhs.index()))
+                return compare_values(static_cast<unsigned long long>(to_integer(lhs)),
+                    static_cast<unsigned long long>(to_integer(rhs)));
+            if (!is_unsigned(lhs.index()) && !is_unsigned(rhs.index()))
+                return compare_values(to_integer(lhs), to_integer(rhs));
+        }
+        const auto to_double = [](const gb2gc::variant& v) {
+            if (storage_for(v.index()) == storage::floating)
+                return to_floating(v);
+            const auto i = to_integer(v);
+            return is_unsigned(v.index()) ?
+                static_cast<double>(static_cast<unsigned long long>(i)) : static_cast<double>(i);
+        };
+        return compare_floating(to_double(lhs), to_double(rhs));
+    }
+
+    template<class T>
+    void gather(std::vector<T>& values, const std::vector<size_t>& index)
+    {
+        if (values.empty())
+            return;
+        std::vector<T> permuted;
+        permuted.reserve(index.size());
+        for (auto i : index)
+            permuted.emplace_back(std::move(values[i]));
+        values = std::move(permuted);
+    }
+
+    // Tables with fewer rows are sorted on the calling thread
+    constexpr size_t parallel_sort_threshold = 1u << 16;
+
+    template<class Compare>
+    void sort_rows(std::vector<size_t>& index, Compare less)
+    {
+        const auto threads = static_cast<size_t>(gb2gc::thread_pool::hardware_threads());
+        if (index.size() < parallel_sort_threshold || threads < 2)
+        {
+            std::sort(index.begin(), index.end(), less);
+            return;
+        }
+
+        // Sort chunks in parallel, then merge adjacent chunks pairwise
+        auto chunks = (std::min)(threads, index.size() / (parallel_sort_threshold / 4));
+        const auto chunk_size = (index.size() + chunks - 1) / chunks;
+        chunks = (index.size() + chunk_size - 1) / chunk_size;
+        const auto bound = [&](size_t chunk) {
+            return index.begin() + static_cast<std::ptrdiff_t>((std::min)(chunk * chunk_size, index.size()));
+        };
+
+        gb2gc::thread_pool pool(static_cast<unsigned>(chunks));
+        pool.parallel_for(chunks, [&](size_t chunk) {
+            std::sort(bound(chunk), bound(chunk + 1), less);
+        });
+        for (auto width = size_t(1); width < chunks; width *= 2)
+        {
+            const auto merges = (chunks + 2 * width - 1) / (2 * width);
+            pool.parallel_for(merges, [&](size_t merge) {
+                const auto first = merge * 2 * width;
+                if (first + width < chunks)
+                    std::inplace_merge(bound(first), bound(first + width), 
+                        bound((std::min)(first + 2 * width, chunks)), less);
+            });
+        }
+    }
+}
+
+void gb2gc::data_set::column_type::reserve(size_t rows)
+{
+    valid_.reserve(rows);
+    switch (storage_)
+    {
+    case storage::integer:  integers_.reserve(rows); break;
+    case storage::floating: floats_.reserve(rows); break;
+    case storage::string:   codes_.reserve(rows); break;
+    case storage::mixed:    mixed_.reserve(rows); break;
+    default: break;
+    }
+}
+
+gb2gc::variant gb2gc::data_set::column_type::get(size_t index) const
+{
+    if (!valid_[index])
+        return variant();
+    switch (storage_)
+    {
+    case storage::integer:  return from_integer(type_, integers_[index]);
+    case storage::floating: return from_floating(type_, floats_[index]);
+    case storage::string:   return variant(pool().str(codes_[index]));
+    case storage::mixed:    return mixed_[index];
+    default:                return variant();
+    }
+}
+
+void gb2gc::data_set::column_type::set(size_t index, const variant& value)
+{
+    const auto kind = storage_for(value.index());
+    if (kind == storage::none)
+    {
+        valid_[index] = false;
+        if (storage_ == storage::mixed)
+            mixed_[index] = value;
+        return;
+    }
+
+    if (storage_ == storage::none)
+    {
+        // First non-null value determines how values are stored
+        storage_ = kind;
+        type_ = value.index();
+        resize(rows_);
+    }
+    else if (storage_ != storage::mixed && (storage_ != kind || type_ != value.index()))
+    {
+        make_mixed();
+    }
+
+    valid_[index] = true;
+    switch (storage_)
+    {
+    case storage::integer:  
+        integers_[index] = to_integer(value); 
+        break;
+    case storage::floating: 
+        floats_[index] = to_floating(value); 
+        break;
+    case storage::string:
+        codes_[index] = pool().intern(nonstd::get<12>(value));
+        break;
+    default:
+        mixed_[index] = value;
+        break;
+    }
+}
+
+void gb2gc::data_set::column_type::add_row(const variant& value)
+{
+    resize(rows_ + 1);
+    set(rows_ - 1, value);
+}
+
+void gb2gc::data_set::column_type::resize(size_t rows)
+{
+    rows_ = rows;
+    valid_.resize(rows, false);
+    switch (storage_)
+    {
+    case storage::integer:  integers_.resize(rows); break;
+    case storage::floating: floats_.resize(rows); break;
+    case storage::string:   codes_.resize(rows); break;
+    case storage::mixed:    mixed_.resize(rows); break;
+    default: break;
+    }
+}
+
+gb2gc::string_pool& gb2gc::data_set::column_type::pool() const
+{
+    // Columns not part of a data set have a pool of their own
+    if (!strings_)
+        strings_ = std::make_shared<string_pool>();
+    return *strings_;
+}
+
+void gb2gc::data_set::column_type::make_mixed()
+{
+    std::vector<variant> mixed;
+    mixed.reserve(rows_);
+    for (auto i = size_t(0); i < rows_; ++i)
+        mixed.emplace_back(get(i));
+    integers_ = std::vector<long long>();
+    floats_ = std::vector<double>();
+    codes_ = std::vector<string_pool::code_type>();
+    mixed_ = std::move(mixed);
+    storage_ = storage::mixed;
+}
+
+bool gb2gc::data_set::column_type::number(size_t index, double& value) const
+{
+    if (!valid_[index])
+        return false;
+    switch (storage_)
+    {
+    case storage::integer:
+        value = is_unsigned(type_) ?
+            static_cast<double>(static_cast<unsigned long long>(integers_[index])) :
+            static_cast<double>(integers_[index]);
+        return true;
+    case storage::floating:
+        value = floats_[index];
+        return true;
+    case storage::mixed:
+        return gb2gc::to_number(mixed_[index], value);
+    default:
+        return false;
+    }
+}
+
+bool gb2gc::to_number(const variant& v, double& value)
+{
+    const auto kind = storage_for(v.index());
+    if (kind == storage::floating)
+    {
+        value = to_floating(v);
+        return true;
+    }
+    if (kind == storage::integer)
+    {
+        const auto i = to_integer(v);
+        value = is_unsigned(v.index()) ?
+            static_cast<double>(static_cast<unsigned long long>(i)) : static_cast<double>(i);
+        return true;
+    }
+    return false;
+}
+
+int gb2gc::data_set::column_type::compare(size_t lhs, size_t rhs) const
+{
+    if (!valid_[lhs] || !valid_[rhs])
+        return compare_values(valid_[lhs], valid_[rhs]);
+    switch (storage_)
+    {
+    case storage::integer:
+        if (is_unsigned(type_))
+            return compare_values(static_cast<unsigned long long>(integers_[lhs]),
+                static_cast<unsigned long long>(integers_[rhs]));
+        return compare_values(integers_[lhs], integers_[rhs]);
+    case storage::floating:
+        return compare_floating(floats_[lhs], floats_[rhs]);
+    case storage::string:
+    {
+        const auto l = codes_[lhs];
+        const auto r = codes_[rhs];
+        if (l == r)
+            return 0;
+        const auto& strings = pool();
+        return compare_strings(strings.data(l), strings.size(l), 
+            strings.data(r), strings.size(r));
+    }
+    case storage::mixed:
+        return compare_variants(mixed_[lhs], mixed_[rhs]);
+    default:
+        return 0;
+    }
+}
+
+void gb2gc::data_set::column_type::permute(const std::vector<size_t>& index)
+{
+    if (index.size() != rows_)
+        throw std::invalid_argument("permutation size do not match number of rows");
+
+    std::vector<bool> valid(rows_);
+    for (auto i = size_t(0); i < rows_; ++i)
+        valid[i] = valid_[index[i]];
+    valid_ = std::move(valid);
+    gather(integers_, index);
+    gather(floats_, index);
+    gather(codes_, index);
+    gather(mixed_, index);
+}
+
+std::vector<size_t> 
+gb2gc::data_set::sort_index(const std::vector<sort_key>& keys) const
+{
+    for (const auto& key : keys)
+    {
+        if (key.col_index >= cols())
+            throw std::out_of_range("sort key column index out of range");
+    }
+
+    std::vector<size_t> index(rows());
+    for (auto i = size_t(0); i < index.size(); ++i)
+        index[i] = i;
+
+    // Ties are broken by row index which makes the order total and the
+    // sort stable without requiring a stable sort algorithm
+    sort_rows(index, [&](size_t lhs, size_t rhs) {
+        for (const auto& key : keys)
+        {
+            const auto result = columns_[key.col_index].compare(lhs, rhs);
+            if (result != 0)
+                return key.descending ? result > 0 : result < 0;
+        }
+        return lhs < rhs;
+    });
+    return index;
+}
+
+void gb2gc::data_set::permute(const std::vector<size_t>& index)
+{
+    for (auto& col : columns_)
+        col.permute(index);
+}
+
+void gb2gc::data_set::sort(const std::vector<sort_key>& keys)
+{
+    permute(sort_index(keys));
+}
+
+void gb2gc::data_set::sort(size_t col_index, bool descending)
+{
+    sort({ sort_key{ col_index, descending } });
+}
+
 std::ostream& gb2gc::operator<<(
    std::ostream& os, const gb2gc::data_set::const_row_iterator& rit)
 {
@@ -5,9 +5,12 @@
 #ifndef GB2GC_DATA_SET_H
 #define GB2GC_DATA_SET_H
 
+#include <memory>
+#include <string>
 #include <type_traits>
 #include <vector>
 
+#include "string_pool.h"
 #include "variant.h"
 
 namespace gb2gc {
@@ -47,35 +50,155 @@ public:
     { 
         columns_.reserve(columns.size());
         for (auto& name : columns)
-            columns_.emplace_back(std::move(name));
+            add_column(name);
     }
 
+    // Column of values stored according to their type. Integer values are
+    // stored in a contiguous int64 array, floating point values in a 
+    // contiguous double array and strings as 32-bit codes into a string pool
+    // shared by all columns of a data set. Nulls are tracked by a bitmap. A
+    // column holds values of a single variant alternative, assigning values
+    // of another alternative falls back to storing variants.
     struct column_type
     {
+        enum class storage : unsigned char
+        {
+            none,     // only nulls
+            integer,  // int64 array
+            floating, // double array
+            string,   // string pool codes
+            mixed     // variant array
+        };
+
+        // Reference to a cell which reads and writes the typed storage
+        class reference
+        {
+        public:
+            reference(column_type& column, size_t row) noexcept :
+            column_(column), row_(row)
+            { }
+
+            reference& operator=(const variant& value)
+            {
+            column_.set(row_, value);
+            return *this;
+            }
+
+            reference& operator=(const reference& other)
+            {
+            return *this = static_cast<variant>(other);
+            }
+
+            operator variant() const { return column_.get(row_); }
+
+            template<class T>
+            T get() const { return column_.get(row_).template get<T>(); }
+
+            size_t index() const { return column_.get(row_).index(); }
+
+            friend bool operator==(const reference& lhs, const variant& rhs)
+            {
+            return static_cast<variant>(lhs) == rhs;
+            }
+
+            friend bool operator==(const variant& lhs, const reference& rhs)
+            {
+            return lhs == static_cast<variant>(rhs);
+            }
+
+            friend bool operator!=(const reference& lhs, const variant& rhs)
+            {
+            return !(lhs == rhs);
+            }
+
+            friend bool operator!=(const variant& lhs, const reference& rhs)
+            {
+            return !(lhs == rhs);
+            }
+
+            friend std::ostream& operator<<(std::ostream& os, const reference& r)
+            {
+            return os << static_cast<variant>(r);
+            }
+
+        private:
+            column_type& column_;
+            size_t row_;
+        };
+
         column_type(std::string name = std::string(), size_t rows = 0) :
-        name_(std::move(name)), data_(rows)
-        {}
+        name_(std::move(name)), rows_(0), type_(0), storage_(storage::none)
+        {
+            resize(rows);
+        }
         ~column_type() noexcept = default;
         column_type(const column_type&) = default;
         column_type& operator=(const column_type&) = default;
         column_type(column_type&& other) = default;
         column_type& operator=(column_type&& other) = default;
 
-        variant& operator[](size_t index) { return data_[index]; }
-        const variant& operator[](size_t index) const { return data_[index]; }
-        size_t size() const { return data_.size(); }
+        reference operator[](size_t index) { return reference(*this, index); }
+        variant operator[](size_t index) const { return get(index); }
+        size_t size() const { return rows_; }
         size_t rows() const { return size(); }
-        bool empty() const { return data_.empty(); }
-        void reserve(size_t rows) { data_.reserve(rows); }
+        bool empty() const { return rows_ == 0; }
+        void reserve(size_t rows);
         const std::string& name() const { return name_; }
         void set_name(const char* name) { name_ = name; }
         void set_name(const std::string& name) { name_ = name; }
-    private:
-        void add_row(variant value = variant{}) { data_.emplace_back(std::move(value)); }
-        void resize(size_t rows) { data_.resize(rows); }
 
-        std::string name_;
-        std::vector<variant> data_;
+        // Returns how values are stored and, unless only nulls are stored,
+        // the variant alternative index of the stored values
+        storage storage_type() const noexcept { return storage_; }
+        size_t type_index() const noexcept { return type_; }
+
+        bool is_null(size_t index) const { return !valid_[index]; }
+
+        // Returns a non-null value in a column with integer storage, values
+        // of unsigned alternatives are stored in two's complement
+        long long integer(size_t index) const { return integers_[index]; }
+
+        // Returns a non-null value in a column with floating storage
+        double floating(size_t index) const { return floats_[index]; }
+
+        // Returns the string pool code of a non-null value in a column with
+        // string storage
+        string_pool::code_type code(size_t index) const { return codes_[index]; }
+
+        // Returns the pool holding the strings of this column
+        const string_pool& strings() const { return pool(); }
+
+        variant get(size_t index) const;
+        void set(size_t index, const variant& value);
+
+        // Returns true and assigns the value of the given row converted to
+        // double if it holds a number, else returns false
+        bool number(size_t index, double& value) const;
+
+        // Compares the values of two rows, returning a negative value, zero
+        // or a positive value. Nulls order first, numbers are compared 
+        // numerically and strings lexicographically.
+        int compare(size_t lhs, size_t rhs) const;
+
+        // Reorders values such that row i holds the value of row index[i]
+        void permute(const std::vector<size_t>& index);
+
+    private:
+        void add_row(const variant& value = variant{});
+        void resize(size_t rows);
+        void make_mixed();
+        string_pool& pool() const;
+
+        std::string                   name_;
+        size_t                        rows_;
+        size_t                        type_;
+        storage                       storage_;
+        std::vector<bool>             valid_;      // null bitmap
+        std::vector<long long>        integers_;
+        std::vector<double>           floats_;
+        std::vector<string_pool::code_type> codes_;
+        mutable std::shared_ptr<string_pool> strings_;
+        std::vector<variant>          mixed_;
 
         friend class data_set;
     };
@@ -88,12 +211,7 @@ public:
         ds_(ds), col_(col), row_(row)
         { }
 
-        const variant& operator->() const
-        {
-        return ds_->get_col(col_)[row_];
-        }
-
-        const variant& operator*() const
+        variant operator*() const
         {
         return ds_->get_col(col_)[row_];
         }
@@ -130,12 +248,7 @@ public:
         ds_(ds), col_(col), row_(row)
         { }
 
-        variant& operator->() const
-        {
-        return ds_->get_col(col_)[row_];
-        }
-
-        variant& operator*() const
+        column_type::reference operator*() const
         {
         return ds_->get_col(col_)[row_];
         }
@@ -184,9 +297,9 @@ public:
         return const_row_value_iterator(ds_, ds_->cols(), ri_);
         }
 
-        const variant& operator[](size_t column_index) const
+        variant operator[](size_t column_index) const
         {
-        return ds_->columns_[column_index][ri_];
+        return ds_->get_col(column_index)[ri_];
         }
 
         const_row_iterator operator++()
@@ -243,14 +356,9 @@ public:
         return row_value_iterator(ds_, 0, ri_);
         }
 
-        const variant& operator[](size_t column_index) const
+        column_type::reference operator[](size_t column_index) const
         {
-        return ds_->columns_[column_index][ri_];
-        }
-
-        variant& operator[](size_t column_index)
-        {
-        return ds_->columns_[column_index][ri_];
+        return ds_->get_col(column_index)[ri_];
         }
 
         row_iterator operator++()
@@ -373,6 +481,8 @@ public:
     void resize_cols(size_t cols)
     {
         columns_.resize(cols);
+        for (auto& col : columns_)
+            share_strings(col);
     }
 
     void resize_rows(size_t rows)
@@ -415,6 +525,13 @@ public:
     void add_column(const std::string& name)
     {
         columns_.emplace_back(std::move(column_type{ name, rows() }));
+        share_strings(columns_.back());
+    }
+
+    // Returns the string pool shared by all columns
+    const string_pool& strings() const
+    {
+        return *shared_strings();
     }
 
     void add_row()
@@ -477,9 +594,38 @@ public:
         }
     }
 
-    // TODO Consider implementing sort(size_t col_index) 
+    // Key of a multi-column sort
+    struct sort_key
+    {
+        size_t col_index;
+        bool   descending;
+    };
+
+    // Returns the permutation of row indices ordering rows by the given keys,
+    // rows with equal keys keep their relative order. Large tables are 
+    // sorted in parallel.
+    std::vector<size_t> sort_index(const std::vector<sort_key>& keys) const;
+
+    // Reorders all columns such that row i holds the values of row index[i]
+    void permute(const std::vector<size_t>& index);
+
+    void sort(const std::vector<sort_key>& keys);
+    void sort(size_t col_index, bool descending = false);
 
 private:
+    const std::shared_ptr<string_pool>& shared_strings() const
+    {
+        if (!strings_)
+            strings_ = std::make_shared<string_pool>();
+        return strings_;
+    }
+
+    void share_strings(column_type& col)
+    {
+        if (!col.strings_ && col.codes_.empty())
+            col.strings_ = shared_strings();
+    }
+
     template<class T, class... Args>
     void add_row_item(size_t index, T&& v, Args&&... args)
     {
@@ -497,8 +643,13 @@ private:
     }
 
     data_type columns_;
+    mutable std::shared_ptr<string_pool> strings_;
 };
 
+// Returns true and the value of the given variant as a double if it holds a
+// number, false if it holds null or a string
+bool to_number(const variant& v, double& value);
+
 std::ostream& operator<<(std::ostream& os, const data_set::const_row_iterator& rit);
 std::ostream& operator<<(std::ostream& os, const data_set& ds);
 
@@ -0,0 +1,67 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "data_set_view.h"
+
+#include <stdexcept>
+
+gb2gc::data_set_view::data_set_view(std::shared_ptr<const data_set> ds)
+    : data_(std::move(ds)), first_(0), count_(0)
+{
+    if (!data_)
+        throw std::invalid_argument("data set view requires a data set");
+    cols_.resize(data_->cols());
+    for (auto i = size_t(0); i < cols_.size(); ++i)
+        cols_[i] = i;
+    count_ = data_->rows();
+}
+
+gb2gc::data_set_view::data_set_view(const data_set& ds)
+    : data_set_view(std::shared_ptr<const data_set>(std::shared_ptr<const data_set>(), &ds))
+{ }
+
+gb2gc::data_set_view
+gb2gc::data_set_view::select(const std::vector<size_t>& cols) const
+{
+    auto view = *this;
+    view.cols_.clear();
+    view.cols_.reserve(cols.size());
+    for (auto col : cols)
+    {
+        if (col >= cols_.size())
+            throw std::out_of_range("data set view column index out of range");
+        view.cols_.emplace_back(cols_[col]);
+    }
+    return view;
+}
+
+gb2gc::data_set_view
+gb2gc::data_set_view::slice(size_t first, size_t count) const
+{
+    if (first > count_ || count > count_ - first)
+        throw std::out_of_range("data set view row slice out of range");
+    auto view = *this;
+    view.first_ = first_ + first;
+    view.count_ = count;
+    return view;
+}
+
+gb2gc::data_set_view
+gb2gc::data_set_view::filter(const std::vector<size_t>& rows) const
+{
+    auto index = std::make_shared<std::vector<size_t>>();
+    index->reserve(rows.size());
+    for (auto row : rows)
+    {
+        if (row >= count_)
+            throw std::out_of_range("data set view row index out of range");
+        index->emplace_back(row_index(row));
+    }
+
+    auto view = *this;
+    view.first_ = 0;
+    view.count_ = index->size();
+    view.rows_ = std::move(index);
+    return view;
+}
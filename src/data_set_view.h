@@ -0,0 +1,89 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_DATA_SET_VIEW_H
+#define GB2GC_DATA_SET_VIEW_H
+
+#include <memory>
+#include <vector>
+
+#include "data_set.h"
+
+namespace gb2gc {
+
+// Read-only view of a subset of the columns and rows of a data set. Views
+// share the underlying data set and never copy cell values, hence many
+// views, e.g. one per chart, may be created from a single parsed table.
+// Deriving a view from a view composes column projections, row slices and
+// row filters, with indices always relative to the view being derived from.
+class data_set_view
+{
+public:
+    // Constructs a view of all columns and rows of the given data set
+    explicit data_set_view(std::shared_ptr<const data_set> ds);
+
+    // Constructs a view of all columns and rows of the given data set which
+    // is not owned by the view and must outlive it
+    explicit data_set_view(const data_set& ds);
+
+    size_t cols() const noexcept { return cols_.size(); }
+    size_t rows() const noexcept { return count_; }
+    bool empty() const noexcept { return cols_.empty() || count_ == 0; }
+
+    const data_set::column_type& get_col(size_t col) const
+    {
+        return data_->get_col(cols_[col]);
+    }
+
+    // Returns the row of the underlying data set of the given view row
+    size_t row_index(size_t row) const
+    {
+        return rows_ ? (*rows_)[first_ + row] : first_ + row;
+    }
+
+    variant value(size_t col, size_t row) const
+    {
+        return get_col(col)[row_index(row)];
+    }
+
+    const data_set& data() const noexcept { return *data_; }
+    const string_pool& strings() const { return data_->strings(); }
+
+    // Returns a view of the given columns in the given order
+    data_set_view select(const std::vector<size_t>& cols) const;
+
+    // Returns a view of count rows starting at the given row
+    data_set_view slice(size_t first, size_t count) const;
+
+    // Returns a view of the given rows in the given order
+    data_set_view filter(const std::vector<size_t>& rows) const;
+
+    // Returns a view of the rows for which predicate(view, row) is true
+    template<class Predicate>
+    data_set_view where(Predicate predicate) const
+    {
+        std::vector<size_t> rows;
+        for (auto row = size_t(0); row < count_; ++row)
+        {
+            if (predicate(*this, row))
+                rows.emplace_back(row);
+        }
+        return filter(rows);
+    }
+
+private:
+    std::shared_ptr<const data_set>            data_;
+    std::vector<size_t>                        cols_;  // column projection
+    std::shared_ptr<const std::vector<size_t>> rows_;  // row index, null if all rows
+    size_t                                     first_;
+    size_t                                     count_;
+};
+
+} // namespace gb2gc
+
+#endif // GB2GC_DATA_SET_VIEW_H
@@ -7,39 +7,36 @@
 
 namespace {
 
-std::ostream& format_attribute(std::ostream& os, const gb2gc::format&,
-    const gb2gc::element::attribute& attr)
+void write_element(gb2gc::html_writer& writer, const gb2gc::element& e)
 {
-    os << ' ' << attr.first << "=\"" << attr.second << '"';
-    return os;
-}
-
-void write_content(std::ostream& os, const gb2gc::format& fmt,
-    size_t level, const std::string& in)
-{
-    std::istringstream ss(in);
-    std::string line;
-    while (getline(ss, line))
-        os << gb2gc::indent{ fmt, level } << line << '\n';
-}
+   if (e.has_comment())
+      writer.comment(e.comment());
+   writer.open(e.name());
+   for (const auto& attrib : e.attributes())
+      writer.attr(attrib.first, attrib.second);
 
-std::ostream& close_element(std::ostream& os, const gb2gc::format& fmt,
-    size_t level, const gb2gc::element& e)
-{
-    os << '\n' << fmt.indent(level) << "</" << e.name() << '>' << '\n';
-    return os;
+   if (e.has_convertible_content())
+   {
+      writer.content([&](gb2gc::output_sink& sink,
+         const gb2gc::format& fmt, size_t level)
+      {
+         e.format(sink, fmt, level);
+      });
+   }
+   else if (e.has_content())
+   {
+      writer.text(e.content());
+   }
+   else
+   {
+      for (const auto& c : e.children())
+         write_element(writer, c);
+   }
+   writer.close();
 }
 
 } // namespace
 
-// Indentation formatting
-
-std::ostream& gb2gc::operator<<(std::ostream& os, const indent& ind)
-{
-   const auto cnt = ind.level * ind.fmt.indentation;
-   return (os << std::string(cnt, ' '));
-}
-
 // Element
 
 gb2gc::element::element(const std::string& name)
@@ -125,10 +122,10 @@ const std::string& gb2gc::element::content() const
    return value_;
 }
 
-void gb2gc::element::format(std::ostream& os,
+void gb2gc::element::format(output_sink& sink,
    const gb2gc::format& fmt, size_t level) const
 {
-   convertible_value_(os, fmt, level);
+   convertible_value_(sink, fmt, level);
 }
 
 gb2gc::element&
@@ -152,41 +149,19 @@ gb2gc::element::find_child(const std::string& value)
       [&](const element& e) { return e.name_ == value; });
 }
 
+gb2gc::output_sink& gb2gc::write_dom(
+   output_sink& sink, const element& e, const format& fmt, size_t level)
+{
+   html_writer writer(sink, fmt, level);
+   write_element(writer, e);
+   return sink;
+}
+
 std::ostream& gb2gc::write_dom(
    std::ostream& os, const element& e, const format& fmt, size_t level)
 {
-   const auto ind = fmt.indent(level);
-   if (!fmt.strip_comments && e.has_comment())
-      os << ind << "<!-- " << e.comment() << " -->\n";
-
-   os << ind << '<' << e.name();
-   for (const auto& attrib : e.attributes())
-      format_attribute(os, fmt, attrib);
-   os << '>';
-
-   if (e.has_convertible_content())
-   {
-      os << '\n';
-      e.format(os, fmt, level + 1);
-      os << '\n';
-      os << ind << "</" << e.name() << '>' << '\n';
-   }
-   else if (e.has_content())
-   {
-      os << '\n';
-      write_content(os, fmt, level + 1, e.content());
-      os << ind << "</" << e.name() << '>' << '\n';
-   }
-   else if (e.children().empty())
-   {
-      os << "</" << e.name() << '>' << '\n';
-   }
-   else
-   {
-      os << "\n";
-      for (const auto& c : e.children())
-         write_dom(os, c, fmt, level + 1);
-      os << ind << "</" << e.name() << '>' << '\n';
-   }
+   output_sink sink(os);
+   write_dom(sink, e, fmt, level);
+   sink.flush();
    return os;
 }
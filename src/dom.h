@@ -15,11 +15,12 @@
 #include <sstream>
 #include <vector>
 
+#include "html_writer.h"
+
 namespace gb2gc {
-   
-struct format;
 
-// Simplistic DOM element
+// Simplistic DOM element, an optional builder for documents written with
+// html_writer
 class element
 {
 public:
@@ -32,7 +33,7 @@ public:
     using attribute_iterator = typename attribute_container::iterator;
 
     using convertible = std::function<void(
-        std::ostream&, // os
+        output_sink&,  // sink
         const format&, // fmt
         size_t)>;      // level
 
@@ -79,7 +80,7 @@ public:
     bool  has_convertible_content() const;
     const std::string& comment() const;
     const std::string& content() const;
-    void  format(std::ostream& os, const format& fmt, size_t level) const;
+    void  format(output_sink& sink, const format& fmt, size_t level) const;
 
 private:
     std::string            name_;
@@ -90,25 +91,8 @@ private:
     std::vector<element>   children_;
 };
 
-struct indent
-{
-    const format& fmt;
-    size_t        level;
-};
-
-std::ostream& operator<<(std::ostream& os, const indent& ind);
-
-struct format
-{
-    bool     strip_comments = false;
-    unsigned indentation    = 2;
-
-    inline ::gb2gc::indent indent(size_t level) const
-    {
-        return ::gb2gc::indent{ *this, level };
-    }
-};
-
+output_sink& write_dom(output_sink& sink, const element& e,
+    const format& fmt = format(), size_t level = 0);
 std::ostream& write_dom(std::ostream& os, const element& e,
     const format& fmt = format(), size_t level = 0);
 
@@ -0,0 +1,131 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "downsample.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+   // Returns true and the value of the given cell if it holds a number other
+   // than NaN
+   bool to_valid_number(const gb2gc::data_set::column_type& column, std::size_t index,
+      double& value)
+   {
+      return column.number(index, value) && !std::isnan(value);
+   }
+
+   // Returns the first index of the given bucket of points between the
+   // first and last point
+   std::size_t bucket_first(std::size_t bucket, double bucket_size) noexcept
+   {
+      return static_cast<std::size_t>(std::floor(static_cast<double>(bucket) * bucket_size)) + 1;
+   }
+}
+
+std::vector<std::size_t> gb2gc::lttb(const double* x, const double* y,
+   std::size_t n, std::size_t threshold)
+{
+   std::vector<std::size_t> selected;
+   if (threshold < 3 || threshold >= n)
+   {
+      selected.resize(n);
+      for (auto i = std::size_t(0); i < n; ++i)
+         selected[i] = i;
+      return selected;
+   }
+
+   // Points between the first and last are split into threshold - 2 buckets
+   // and the point of each bucket forming the largest triangle with the
+   // previously selected point and the average of the next bucket is selected
+   selected.reserve(threshold);
+   const auto buckets = threshold - 2;
+   const auto bucket_size = static_cast<double>(n - 2) / static_cast<double>(buckets);
+   auto a = std::size_t(0);
+   selected.emplace_back(a);
+   for (auto bucket = std::size_t(0); bucket < buckets; ++bucket)
+   {
+      const auto first = bucket_first(bucket, bucket_size);
+      const auto last = (std::min)(bucket_first(bucket + 1, bucket_size), n - 1);
+
+      // Average of the next bucket, or the last point for the last bucket
+      const auto next_first = last;
+      const auto next_last = (std::min)(bucket_first(bucket + 2, bucket_size), n);
+      auto avg_x = 0.0;
+      auto avg_y = 0.0;
+      for (auto i = next_first; i < next_last; ++i)
+      {
+         avg_x += x[i];
+         avg_y += y[i];
+      }
+      const auto count = static_cast<double>(next_last - next_first);
+      avg_x /= count;
+      avg_y /= count;
+
+      auto max_area = -1.0;
+      auto max_index = first;
+      for (auto i = first; i < last; ++i)
+      {
+         const auto area = std::fabs(
+            (x[a] - avg_x) * (y[i] - y[a]) - (x[a] - x[i]) * (avg_y - y[a]));
+         if (area > max_area)
+         {
+            max_area = area;
+            max_index = i;
+         }
+      }
+      selected.emplace_back(max_index);
+      a = max_index;
+   }
+   selected.emplace_back(n - 1);
+   return selected;
+}
+
+gb2gc::data_set_view gb2gc::downsample(const data_set_view& view,
+   std::size_t max_points)
+{
+   const auto rows = view.rows();
+   if (max_points == 0 || rows <= max_points || view.cols() < 2)
+      return view;
+
+   std::vector<double> keys(rows);
+   const auto& key_column = view.get_col(0);
+   for (auto row = std::size_t(0); row < rows; ++row)
+   {
+      if (!to_valid_number(key_column, view.row_index(row), keys[row]))
+         keys[row] = static_cast<double>(row);
+   }
+
+   std::vector<bool> keep(rows, false);
+   std::vector<std::size_t> positions;
+   std::vector<double> x;
+   std::vector<double> y;
+   for (auto col = std::size_t(1); col < view.cols(); ++col)
+   {
+      positions.clear();
+      x.clear();
+      y.clear();
+      const auto& column = view.get_col(col);
+      double value;
+      for (auto row = std::size_t(0); row < rows; ++row)
+      {
+         if (!to_valid_number(column, view.row_index(row), value))
+            continue;
+         positions.emplace_back(row);
+         x.emplace_back(keys[row]);
+         y.emplace_back(value);
+      }
+      for (const auto i : lttb(x.data(), y.data(), x.size(), max_points))
+         keep[positions[i]] = true;
+   }
+
+   std::vector<std::size_t> kept;
+   for (auto row = std::size_t(0); row < rows; ++row)
+   {
+      if (keep[row])
+         kept.emplace_back(row);
+   }
+   return view.filter(kept);
+}
@@ -0,0 +1,36 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_DOWNSAMPLE_H
+#define GB2GC_DOWNSAMPLE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "data_set_view.h"
+
+namespace gb2gc
+{
+   // Returns the indices, in ascending order, of at most threshold points of
+   // the series (x[i], y[i]) ordered by x, selected with the Largest-Triangle-
+   // Three-Buckets algorithm. The first and last points are always selected.
+   // All indices are returned if threshold is less than 3 or not less than n.
+   std::vector<std::size_t> lttb(const double* x, const double* y,
+      std::size_t n, std::size_t threshold);
+
+   // Returns a view of the rows needed to draw each series, i.e. each column
+   // but the first key (x) column, of the given view with at most max_points
+   // points while keeping its visual shape. Rows selected for any series are
+   // kept with all their values. Key values which are not numbers are
+   // replaced by their row position and series values which are not numbers
+   // are ignored. Returns the given view if max_points is 0.
+   data_set_view downsample(const data_set_view& view, std::size_t max_points);
+
+} // namespace gb2gc
+
+#endif // GB2GC_DOWNSAMPLE_H
@@ -0,0 +1,124 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "extractor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+std::size_t gb2gc::extracted_column::size() const noexcept
+{
+   return cells.size();
+}
+
+gb2gc::variant
+gb2gc::extracted_column::value(std::size_t row, const token_table& table) const
+{
+   switch (cells[row])
+   {
+   case cell::number: return gb2gc::variant(numbers[row]);
+   case cell::token:  return gb2gc::variant(table.str(tokens[row]));
+   default:           return gb2gc::variant();
+   }
+}
+
+gb2gc::column_extractor::column_extractor(const std::vector<selector>& selectors)
+{
+   programs_.reserve(selectors.size());
+   for (const auto& s : selectors)
+   {
+      program p;
+      p.param = s.is_parameterized();
+      p.name_param = p.param && s.key() == "name";
+      p.param_index = s.is_parameterized() ? s.param_index() : 0u;
+
+      const auto found = std::find(fields_.begin(), fields_.end(), s.key());
+      p.field = static_cast<std::size_t>(found - fields_.begin());
+      if (found == fields_.end())
+         fields_.emplace_back(s.key());
+
+      programs_.emplace_back(p);
+   }
+}
+
+std::vector<gb2gc::extracted_column>
+gb2gc::column_extractor::extract(const benchmark_table& benchmarks,
+   tokenized_names& names, const std::vector<std::size_t>& indices) const
+{
+   std::vector<extracted_column> columns(programs_.size());
+   for (auto& c : columns)
+   {
+      c.cells.resize(indices.size(), extracted_column::cell::null);
+      c.numbers.resize(indices.size());
+      c.tokens.resize(indices.size());
+   }
+
+   // Resolve each distinct field once
+   std::vector<std::size_t> fields(fields_.size());
+   for (auto f = std::size_t(0); f < fields_.size(); ++f)
+      fields[f] = benchmarks.field(fields_[f]);
+
+   auto& table = names.table();
+   const std::string prefix("BM_");
+   std::vector<field_value> values(fields_.size());
+   for (auto row = std::size_t(0); row < indices.size(); ++row)
+   {
+      // Look up each distinct field once per benchmark
+      const auto index = indices[row];
+      for (auto f = std::size_t(0); f < fields_.size(); ++f)
+      {
+         if (fields[f] != benchmark_table::npos)
+            values[f] = benchmarks.value(fields[f], index);
+         if (fields[f] == benchmark_table::npos || values[f].type == field_value::kind::missing)
+            throw std::runtime_error("Benchmark do not have any key '" + fields_[f] + "'");
+      }
+
+      for (auto i = std::size_t(0); i < programs_.size(); ++i)
+      {
+         const auto& p = programs_[i];
+         auto& column = columns[i];
+         const auto& value = values[p.field];
+
+         if (p.name_param)
+         {
+            if (p.param_index >= names.count(index))
+               throw std::runtime_error("Benchmark do not have any parameter " +
+                  std::to_string(p.param_index));
+            column.cells[row] = extracted_column::cell::number;
+            column.numbers[row] = table.number(names.begin(index)[p.param_index]);
+         }
+         else if (value.type == field_value::kind::string && p.param)
+         {
+            const auto splits = split(std::string(value.data, value.size), '/');
+            if (p.param_index >= splits.size())
+               throw std::runtime_error("Benchmark do not have any parameter " +
+                  std::to_string(p.param_index));
+            column.cells[row] = extracted_column::cell::number;
+            column.numbers[row] = std::stod(splits[p.param_index]);
+         }
+         else if (value.type == field_value::kind::string)
+         {
+            // Strings are interned with any benchmark prefix stripped
+            const auto strip = value.size >= prefix.size() &&
+               std::memcmp(value.data, prefix.data(), prefix.size()) == 0 ? prefix.size() : std::size_t(0);
+            column.cells[row] = extracted_column::cell::token;
+            column.tokens[row] = table.intern(value.data + strip, value.size - strip);
+         }
+         else
+         {
+            column.cells[row] = extracted_column::cell::number;
+            column.numbers[row] = value.number;
+         }
+      }
+   }
+   return columns;
+}
+
+std::vector<gb2gc::extracted_column>
+gb2gc::column_extractor::extract(const nlohmann::json& benchmarks,
+   tokenized_names& names, const std::vector<std::size_t>& indices) const
+{
+   return extract(json_benchmark_table(benchmarks), names, indices);
+}
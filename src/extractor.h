@@ -0,0 +1,81 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_EXTRACTOR_H
+#define GB2GC_EXTRACTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "benchmark_table.h"
+#include "gb2gc.h"
+#include "token_table.h"
+#include "variant.h"
+
+namespace gb2gc
+{
+   // Typed column of values extracted by a column_extractor. Numbers are
+   // stored as doubles and strings as token ids.
+   struct extracted_column
+   {
+      enum class cell : std::uint8_t
+      {
+         null   = 0,
+         number = 1,
+         token  = 2
+      };
+
+      std::vector<cell>     cells;
+      std::vector<double>   numbers; // valid for cell::number
+      std::vector<token_id> tokens;  // valid for cell::token
+
+      std::size_t size() const noexcept;
+
+      // Returns the value at the given row as a variant
+      gb2gc::variant value(std::size_t row, const token_table& table) const;
+   };
+
+   // Selectors compiled into column extractors. Each distinct benchmark field
+   // referenced by the selectors is resolved once when compiled and looked up
+   // once per benchmark, parameterized name selectors read the pre-tokenized
+   // benchmark name. Extracted values are equal to the values returned by the
+   // corresponding selector.
+   class column_extractor final
+   {
+   public:
+      explicit column_extractor(const std::vector<selector>& selectors);
+
+      // Extracts one column per selector from the benchmarks at the given
+      // indices in a single pass. Strings are interned into the token table
+      // of names which holds the tokenized benchmark names. Throws
+      // std::runtime_error if a benchmark lacks a selected field.
+      std::vector<extracted_column> extract(const benchmark_table& benchmarks,
+         tokenized_names& names, const std::vector<std::size_t>& indices) const;
+      std::vector<extracted_column> extract(const nlohmann::json& benchmarks,
+         tokenized_names& names, const std::vector<std::size_t>& indices) const;
+
+   private:
+      struct program
+      {
+         std::size_t field;       // index of field in fields_
+         bool        param;       // selects parameter of a string field
+         bool        name_param;  // selects benchmark name parameter
+         unsigned    param_index; // parameter index if param
+      };
+
+      std::vector<std::string> fields_;
+      std::vector<program>     programs_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_EXTRACTOR_H
@@ -0,0 +1,59 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "file_glob.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <glob.h>
+#endif
+
+bool gb2gc::is_glob(const std::string& path)
+{
+   return path.find_first_of("*?") != std::string::npos;
+}
+
+std::vector<std::string> gb2gc::expand_glob(const std::string& pattern)
+{
+   std::vector<std::string> paths;
+   if (!is_glob(pattern))
+   {
+      paths.push_back(pattern);
+      return paths;
+   }
+
+#ifdef _WIN32
+   const auto separator = pattern.find_last_of("/\\");
+   const auto directory = (separator == std::string::npos) ?
+      std::string() : pattern.substr(0, separator + 1);
+
+   WIN32_FIND_DATAA data;
+   const auto handle = ::FindFirstFileA(pattern.c_str(), &data);
+   if (handle != INVALID_HANDLE_VALUE)
+   {
+      do
+      {
+         if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+            paths.push_back(directory + data.cFileName);
+      } while (::FindNextFileA(handle, &data));
+      ::FindClose(handle);
+   }
+#else
+   ::glob_t result;
+   if (::glob(pattern.c_str(), 0, nullptr, &result) == 0)
+   {
+      for (auto i = std::size_t(0); i < result.gl_pathc; ++i)
+         paths.emplace_back(result.gl_pathv[i]);
+   }
+   ::globfree(&result);
+#endif
+
+   std::sort(paths.begin(), paths.end());
+   return paths;
+}
@@ -0,0 +1,28 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_FILE_GLOB_H
+#define GB2GC_FILE_GLOB_H
+
+#include <string>
+#include <vector>
+
+namespace gb2gc
+{
+   // Returns true if the given path contains any wildcard characters ('*', '?')
+   bool is_glob(const std::string& path);
+
+   // Expands the given path pattern into the sorted list of matching paths.
+   // Patterns without wildcards are returned as-is without checking whether
+   // the path exists. On Windows wildcards are only supported in the last
+   // path component.
+   std::vector<std::string> expand_glob(const std::string& pattern);
+
+} // namespace gb2gc
+
+#endif // GB2GC_FILE_GLOB_H
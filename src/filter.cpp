@@ -0,0 +1,169 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "filter.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+   const char regex_prefix[] = "re:";
+   const std::size_t regex_prefix_length = sizeof(regex_prefix) - 1;
+
+   // Matches [first, last) against glob [glob, glob_last) where '*' matches
+   // any sequence and '?' matches any single character.
+   bool match_glob(const char* glob, const char* glob_last,
+      const char* first, const char* last) noexcept
+   {
+      const char* star = nullptr;
+      const char* resume = nullptr;
+      while (first != last)
+      {
+         if (glob != glob_last && (*glob == '?' || *glob == *first))
+         {
+            ++glob;
+            ++first;
+         }
+         else if (glob != glob_last && *glob == '*')
+         {
+            star = glob++;
+            resume = first;
+         }
+         else if (star)
+         {
+            glob = star + 1;
+            first = ++resume;
+         }
+         else
+         {
+            return false;
+         }
+      }
+      while (glob != glob_last && *glob == '*')
+         ++glob;
+      return glob == glob_last;
+   }
+}
+
+gb2gc::benchmark_filter::benchmark_filter()
+   : has_include_(false)
+{ }
+
+gb2gc::benchmark_filter::benchmark_filter(const std::vector<std::string>& patterns)
+   : has_include_(false)
+{
+   for (const auto& text : patterns)
+   {
+      pattern p;
+      p.exclude = !text.empty() && text[0] == '-';
+      p.is_regex = false;
+
+      auto first = p.exclude ? std::size_t(1) : std::size_t(0);
+      if (text.compare(first, regex_prefix_length, regex_prefix) == 0)
+      {
+         p.is_regex = true;
+         try
+         {
+            p.regex = std::regex(text.substr(first + regex_prefix_length),
+               std::regex::ECMAScript | std::regex::optimize);
+         }
+         catch (const std::regex_error& e)
+         {
+            throw std::invalid_argument("Invalid filter regex '" + text + "': " + e.what());
+         }
+      }
+      else
+      {
+         // Same segments as split(pattern, '/')
+         while (first < text.size())
+         {
+            auto last = text.find('/', first);
+            if (last == std::string::npos)
+               last = text.size();
+
+            segment s;
+            s.text = text.substr(first, last - first);
+            if (s.text == "*")
+               s.type = segment::kind::any;
+            else if (s.text.find_first_of("*?") == std::string::npos)
+               s.type = segment::kind::literal;
+            else
+               s.type = segment::kind::glob;
+            p.segments.emplace_back(std::move(s));
+
+            first = last + 1;
+         }
+      }
+
+      has_include_ = has_include_ || !p.exclude;
+      patterns_.emplace_back(std::move(p));
+   }
+}
+
+bool gb2gc::benchmark_filter::empty() const noexcept
+{
+   return patterns_.empty();
+}
+
+bool gb2gc::benchmark_filter::operator()(const char* name, std::size_t size) const
+{
+   auto included = !has_include_;
+   for (const auto& p : patterns_)
+   {
+      if (p.exclude)
+      {
+         if (match(p, name, size))
+            return false;
+      }
+      else if (!included)
+      {
+         included = match(p, name, size);
+      }
+   }
+   return included;
+}
+
+bool gb2gc::benchmark_filter::operator()(const std::string& name) const
+{
+   return (*this)(name.data(), name.size());
+}
+
+bool gb2gc::benchmark_filter::match(const pattern& p, const char* name, std::size_t size)
+{
+   if (p.is_regex)
+      return std::regex_search(name, name + size, p.regex);
+
+   const auto last = name + size;
+   auto first = name;
+   for (const auto& s : p.segments)
+   {
+      if (first >= last)
+         break; // no more name segments
+      auto segment_last = static_cast<const char*>(
+         std::memchr(first, '/', static_cast<std::size_t>(last - first)));
+      if (!segment_last)
+         segment_last = last;
+
+      switch (s.type)
+      {
+      case segment::kind::any:
+         break;
+      case segment::kind::literal:
+         if (static_cast<std::size_t>(segment_last - first) != s.text.size() ||
+             std::memcmp(first, s.text.data(), s.text.size()) != 0)
+            return false;
+         break;
+      case segment::kind::glob:
+         if (!match_glob(s.text.data(), s.text.data() + s.text.size(), first, segment_last))
+            return false;
+         break;
+      }
+
+      if (segment_last == last)
+         break; // last name segment
+      first = segment_last + 1;
+   }
+   return true;
+}
@@ -0,0 +1,80 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_FILTER_H
+#define GB2GC_FILTER_H
+
+#include <cstddef>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace gb2gc
+{
+   // Benchmark name filter compiled from a set of patterns. A benchmark
+   // passes the filter if it matches any include pattern, or there are no
+   // include patterns, and do not match any exclude pattern.
+   //
+   // Patterns are of the form:
+   //
+   //   [-]segment[/segment...]   Segment glob. Each '/' separated segment of
+   //                             the benchmark name is matched against the
+   //                             corresponding segment of the pattern where
+   //                             '*' matches any sequence and '?' matches any
+   //                             single character. Segments beyond the
+   //                             shorter of pattern and name are not compared.
+   //   [-]re:regex               ECMAScript regular expression matching any
+   //                             part of the benchmark name, i.e. the same
+   //                             semantics as Google Benchmark's
+   //                             --benchmark_filter.
+   //
+   // A leading '-' makes the pattern an exclude pattern.
+   class benchmark_filter final
+   {
+   public:
+      // Constructs a filter passing all benchmarks
+      benchmark_filter();
+
+      // Compiles the given patterns. Throws std::invalid_argument if any
+      // pattern is invalid.
+      explicit benchmark_filter(const std::vector<std::string>& patterns);
+
+      // Returns true if this filter passes all benchmarks
+      bool empty() const noexcept;
+
+      // Returns true if the benchmark with the given name passes the filter.
+      // Segment globs are matched in place without allocating.
+      bool operator()(const char* name, std::size_t size) const;
+      bool operator()(const std::string& name) const;
+
+   private:
+      struct segment
+      {
+         enum class kind { any, literal, glob };
+
+         kind        type;
+         std::string text;
+      };
+
+      struct pattern
+      {
+         bool                 exclude;
+         bool                 is_regex;
+         std::vector<segment> segments;
+         std::regex           regex;
+      };
+
+      static bool match(const pattern& p, const char* name, std::size_t size);
+
+      std::vector<pattern> patterns_;
+      bool                 has_include_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_FILTER_H
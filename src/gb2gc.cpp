@@ -2,46 +2,43 @@
 // This file is subject to the license terms in the LICENSE file found in the 
 // root directory of this distribution.
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
+#include <stdexcept>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <nlohmann/json.hpp>
 
 #include "chart.h"
+#include "downsample.h"
+#include "extractor.h"
 #include "gb2gc.h"
-
-int gb2gc::run(int argc, const char* argv[])
+#include "manifest.h"
+#include "reader.h"
+#include "snapshot.h"
+#include "svg_chart.h"
+#include "thread_pool.h"
+
+// Converts the benchmarks to a data-set and writes it as a chart, dashboard
+// or SVG chart based on given options
+void write_output(const gb2gc::options& options, const gb2gc::benchmark_table& benchmarks)
 {
-   gb2gc::options options;
-   auto err = options.parse(argc, argv);
-   if (err)
-      return err;
-   write_chart(options, parse_data(options, parse_json(options.in_file())));
-   return 0; // success
-}
-
-nlohmann::json gb2gc::parse_json(const std::string& file)
-{
-   // Due to an issue in google benchmark it will not encode backslashes
-   // correctly which forces us to load json as string and do proper escaping
-   // before attempting to parse it. Stream API would be preferrable instead.
-
-   std::ifstream in(file, std::fstream::in);
-   if (!in)
-   {
-      std::cerr << "Error: File non-existent or failed to open file: " << file << "\n";
-      return 1;
-   }
-
-   std::string content(
-      (std::istreambuf_iterator<char>(in)),
-      (std::istreambuf_iterator<char>()));
-   in.close();
-   std::replace(content.begin(), content.end(), '\\', '/');
-
-   return nlohmann::json::parse(content);
+   const auto data_set = std::make_shared<const gb2gc::data_set>(
+      gb2gc::parse_data(options, benchmarks));
+   const auto view = gb2gc::downsample(
+      gb2gc::data_set_view(data_set), options.max_points());
+   if (options.svg())
+      gb2gc::write_svg_chart(options, view);
+   else if (options.dashboard())
+      gb2gc::write_dashboard(options, view);
+   else
+      gb2gc::write_chart(options, view);
 }
 
 std::string make_title(const std::string title)
@@ -72,7 +69,7 @@ std::string make_title(const std::string title)
 struct series
 {
    std::string name;
-   std::vector<nlohmann::json::const_iterator> benchmarks;
+   std::vector<std::size_t> benchmarks; // indices of benchmarks
 };
 
 struct series_object
@@ -93,95 +90,479 @@ gb2gc::selector* find_key(std::vector<gb2gc::selector>& selectors)
    return &*key;
 }
 
-std::vector<std::string>
-split_attribute(const nlohmann::json::const_iterator bm, const std::string& attribute)
+const std::string& attribute(const nlohmann::json& bm, const std::string& attribute)
 {
-   const auto name = bm->find(attribute);
-   if (name == bm->end())
-      throw std::exception(); // TODO Carry message?!
+   const auto name = bm.find(attribute);
+   if (name == bm.end())
+      throw std::runtime_error("Benchmark do not have any key '" + attribute + "'");
    if (!name->is_string())
-      throw std::exception(); // TODO Carry message?!
-   return gb2gc::split(name->get<std::string>(), '/');
+      throw std::runtime_error("Benchmark key '" + attribute + "' is not a string");
+   return name->get_ref<const std::string&>();
+}
+
+bool accept(const nlohmann::json& bm, const gb2gc::benchmark_filter& filter)
+{
+   return filter.empty() || filter(attribute(bm, "name"));
+}
+
+// Returns the string value of the given field of the benchmark at the given
+// index, see attribute above
+gb2gc::field_value attribute(const gb2gc::benchmark_table& benchmarks,
+   std::size_t field, std::size_t index, const std::string& attribute)
+{
+   const auto value = field == gb2gc::benchmark_table::npos ?
+      gb2gc::field_value() : benchmarks.value(field, index);
+   if (value.type == gb2gc::field_value::kind::missing)
+      throw std::runtime_error("Benchmark do not have any key '" + attribute + "'");
+   if (value.type != gb2gc::field_value::kind::string)
+      throw std::runtime_error("Benchmark key '" + attribute + "' is not a string");
+   return value;
+}
+
+bool accept(const gb2gc::benchmark_table& benchmarks, std::size_t name, std::size_t index,
+   const gb2gc::benchmark_filter& filter)
+{
+   if (filter.empty())
+      return true;
+   const auto value = attribute(benchmarks, name, index, "name");
+   return filter(value.data, value.size);
+}
+
+// Returns true if any selector aggregates repeated benchmarks
+bool is_aggregated(const std::vector<gb2gc::selector>& selectors)
+{
+   return std::any_of(selectors.begin(), selectors.end(),
+      [](const gb2gc::selector& s) { return s.is_aggregated(); });
+}
+
+// Returns true if the benchmark at the given index is an aggregate computed
+// by Google Benchmark over repetitions, e.g. 'BM_Foo/8_mean'
+bool is_aggregate(const gb2gc::benchmark_table& benchmarks, std::size_t run_type,
+   std::size_t index)
+{
+   if (run_type == gb2gc::benchmark_table::npos)
+      return false;
+   const auto value = benchmarks.value(run_type, index);
+   const std::string aggregate("aggregate");
+   return value.type == gb2gc::field_value::kind::string && value.size == aggregate.size() &&
+      std::memcmp(value.data, aggregate.data(), aggregate.size()) == 0;
+}
+
+using benchmark_callback = gb2gc::benchmark_reader::callback;
+
+// Streams all benchmarks of the given Google Benchmark JSON file through the
+// SAX reader. Only the given fields are retained for each benchmark, or all
+// fields if no fields are specified.
+void read_benchmarks(const std::string& file, std::vector<std::string> fields,
+   const benchmark_callback& on_benchmark)
+{
+   // Due to an issue in google benchmark it will not encode backslashes
+   // correctly which forces us to do escaping while reading the input
+   gb2gc::benchmark_input in(file);
+   std::istream stream(in.rdbuf());
+
+   gb2gc::benchmark_reader reader(std::move(fields), on_benchmark);
+   nlohmann::json::sax_parse(stream, &reader);
+}
+
+// Removes all fields not in the given set of fields from the benchmark
+void retain(nlohmann::json& bm, const std::vector<std::string>& fields)
+{
+   if (fields.empty())
+      return;
+   for (auto it = bm.begin(); it != bm.end(); )
+   {
+      if (std::find(fields.begin(), fields.end(), it.key()) == fields.end())
+         it = bm.erase(it);
+      else
+         ++it;
+   }
+}
+
+// Opens the snapshot of the given file. A missing or stale snapshot is
+// (re)created from all benchmark fields so that it may be reused with other
+// options. If the snapshot cannot be written, the benchmarks parsed when
+// creating it are returned as an array in 'parsed' instead. Returns false if
+// the input is not a regular file in which case snapshots cannot be used.
+bool open_snapshot(const std::string& file, gb2gc::snapshot& snapshot, nlohmann::json& parsed)
+{
+   gb2gc::input_signature signature;
+   if (gb2gc::is_standard_input(file) || !signature.read(file))
+      return false;
+
+   const auto path = gb2gc::snapshot::path_for(file);
+   if (snapshot.open(path, signature))
+      return true;
+
+   parsed = nlohmann::json::array();
+   read_benchmarks(file, std::vector<std::string>(),
+      [&](nlohmann::json&& bm) { parsed.emplace_back(std::move(bm)); });
+   if (gb2gc::snapshot::write(path, signature, parsed) && snapshot.open(path, signature))
+      parsed = nlohmann::json();
+   return true;
+}
+
+// Reads benchmarks from the snapshot of the given file, see open_snapshot.
+// Returns false if snapshots cannot be used for the input.
+bool read_snapshot(const std::string& file, const std::vector<std::string>& fields,
+   const benchmark_callback& on_benchmark)
+{
+   gb2gc::snapshot snapshot;
+   nlohmann::json parsed;
+   if (!open_snapshot(file, snapshot, parsed))
+      return false;
+
+   if (parsed.is_array())
+   {
+      // Snapshot could not be written, proceed with what has been parsed
+      for (auto& bm : parsed)
+      {
+         retain(bm, fields);
+         on_benchmark(std::move(bm));
+      }
+      return true;
+   }
+
+   snapshot.read(fields, on_benchmark);
+   return true;
+}
+
+// Reads the given Google Benchmark JSON file, or its snapshot if enabled,
+// retaining only benchmarks passing the filter and the given fields.
+nlohmann::json read_json(const std::string& file,
+   std::vector<std::string> fields, const gb2gc::benchmark_filter& filter, bool use_snapshot)
+{
+   auto result = nlohmann::json::object();
+   auto& benchmarks = result["benchmarks"] = nlohmann::json::array();
+   const benchmark_callback on_benchmark = [&](nlohmann::json&& bm)
+   {
+      if (accept(bm, filter))
+         benchmarks.emplace_back(std::move(bm));
+   };
+
+   if (!use_snapshot || !read_snapshot(file, fields, on_benchmark))
+      read_benchmarks(file, std::move(fields), on_benchmark);
+   return result;
+}
+
+nlohmann::json gb2gc::parse_json(const std::string& file)
+{
+   return read_json(file, std::vector<std::string>(), gb2gc::benchmark_filter(), false);
+}
+
+// Returns the benchmark fields required by the given options. The benchmark
+// name is always required for filtering and series, other fields are only
+// required if referenced by a selector or for aggregating repetitions.
+std::vector<std::string> required_fields(const gb2gc::options& options)
+{
+   std::vector<std::string> fields({ "name" });
+   if (is_aggregated(options.selectors()))
+      fields.emplace_back("run_type");
+   for (const auto& s : options.selectors())
+   {
+      if (std::find(fields.begin(), fields.end(), s.key()) == fields.end())
+         fields.emplace_back(s.key());
+   }
+   return fields;
+}
+
+nlohmann::json gb2gc::parse_json(const std::string& file, const options& options)
+{
+   return read_json(file, required_fields(options), options.filter(), options.snapshot());
+}
+
+// Calls fn with the index of each of the given number of files, in parallel
+// if there are multiple files
+template<class Function>
+void for_each_file(std::size_t count, Function fn)
+{
+   if (count > 1)
+   {
+      gb2gc::thread_pool pool(static_cast<unsigned>((std::min)(
+         count, static_cast<std::size_t>(gb2gc::thread_pool::hardware_threads()))));
+      pool.parallel_for(count, fn);
+   }
+   else if (count == 1)
+   {
+      fn(0);
+   }
+}
+
+nlohmann::json gb2gc::parse_json(const std::vector<std::string>& files, const options& options)
+{
+   // Parse each file into a separate result to avoid synchronization and
+   // merge them in the given order to get a deterministic result
+   std::vector<nlohmann::json> results(files.size());
+   auto parse = [&](std::size_t i)
+   {
+      results[i] = parse_json(files[i], options);
+      for (auto& bm : results[i]["benchmarks"])
+         bm["input_file"] = files[i];
+   };
+   for_each_file(files.size(), parse);
+
+   auto result = nlohmann::json::object();
+   auto& benchmarks = result["benchmarks"] = nlohmann::json::array();
+   for (auto& r : results)
+   {
+      for (auto& bm : r["benchmarks"])
+         benchmarks.emplace_back(std::move(bm));
+   }
+   return result;
+}
+
+// Benchmarks of an input file, read directly from the memory-mapped snapshot
+// of the file or parsed from JSON
+struct input_benchmarks
+{
+   gb2gc::snapshot snapshot;
+   nlohmann::json  parsed; // array of benchmarks unless mapped
+   bool            mapped = false;
+};
+
+// Reads the benchmarks of the given file, from its snapshot if enabled.
+// Benchmarks parsed from JSON only retain the given fields of the benchmarks
+// passing the filter.
+void read_input(const std::string& file, std::vector<std::string> fields,
+   const gb2gc::benchmark_filter& filter, bool use_snapshot, input_benchmarks& input)
+{
+   if (use_snapshot && open_snapshot(file, input.snapshot, input.parsed))
+   {
+      input.mapped = !input.parsed.is_array();
+      return;
+   }
+   auto result = read_json(file, std::move(fields), filter, false);
+   input.parsed = std::move(result["benchmarks"]);
+}
+
+// Converts the benchmarks of the given inputs merged in the given order, see
+// merged_benchmark_table, and writes them based on given options
+void write_output(const gb2gc::options& options,
+   const std::vector<const input_benchmarks*>& inputs, const std::vector<std::string>& files)
+{
+   std::vector<std::unique_ptr<gb2gc::json_benchmark_table>> json_tables;
+   std::vector<const gb2gc::benchmark_table*> tables;
+   for (const auto input : inputs)
+   {
+      if (input->mapped)
+      {
+         tables.emplace_back(&input->snapshot);
+         continue;
+      }
+      json_tables.emplace_back(new gb2gc::json_benchmark_table(input->parsed));
+      tables.emplace_back(json_tables.back().get());
+   }
+   write_output(options, gb2gc::merged_benchmark_table(std::move(tables), files));
+}
+
+int gb2gc::run(int argc, const char* argv[])
+{
+   gb2gc::options options;
+   auto err = options.parse(argc, argv);
+   if (err)
+      return err;
+
+   if (!options.manifest().empty())
+   {
+      gb2gc::manifest manifest;
+      err = manifest.read(options.manifest());
+      if (err)
+         return err;
+      return run(manifest);
+   }
+
+   // Standard input is only accessed via std::cin, unsynchronized access
+   // allows reading whatever is available from a pipe without blocking
+   // for a full buffer.
+   const auto& files = options.in_files();
+   if (std::any_of(files.begin(), files.end(), gb2gc::is_standard_input))
+      std::ios::sync_with_stdio(false);
+   const auto fields = required_fields(options);
+   std::vector<input_benchmarks> inputs(files.size());
+   for_each_file(files.size(), [&](std::size_t i)
+   {
+      read_input(files[i], fields, options.filter(), options.snapshot(), inputs[i]);
+   });
+
+   std::vector<const input_benchmarks*> all;
+   for (const auto& input : inputs)
+      all.emplace_back(&input);
+   write_output(options, all, files);
+   return 0; // success
 }
 
-bool accept(const nlohmann::json::const_iterator bm, const std::vector<std::string>& filter_splits)
+int gb2gc::run(const manifest& manifest)
 {
-   if (!filter_splits.empty())
+   const auto& inputs = manifest.inputs();
+   const auto& charts = manifest.charts();
+   if (std::any_of(inputs.begin(), inputs.end(), gb2gc::is_standard_input))
+      std::ios::sync_with_stdio(false);
+
+   // Charts waiting for each input and the number of distinct inputs each
+   // chart is still waiting for. An input is read with a snapshot if any
+   // chart reading it asks for it.
+   std::vector<std::vector<std::size_t>> waiting(inputs.size());
+   std::unique_ptr<std::atomic<std::size_t>[]> remaining(
+      new std::atomic<std::size_t>[charts.size()]);
+   std::vector<char> use_snapshot(inputs.size(), 0);
+   for (auto c = std::size_t(0); c < charts.size(); ++c)
    {
-      const auto splits = split_attribute(bm, "name");
-      for (auto i = 0u; i < splits.size() && i < filter_splits.size(); ++i)
+      std::set<std::size_t> distinct(charts[c].inputs.begin(), charts[c].inputs.end());
+      remaining[c] = distinct.size();
+      for (auto i : distinct)
       {
-         const auto& filter_value = filter_splits[i];
-         if (filter_value != "*" && filter_value != splits[i])
-            return false; // no match
+         waiting[i].emplace_back(c);
+         if (charts[c].options.snapshot())
+            use_snapshot[i] = 1;
       }
    }
-   return true; // match
+
+   // Each input is parsed once retaining all benchmarks and fields since it
+   // may be shared by charts with different filters and selectors. Charts
+   // render concurrently from the shared inputs which are only read.
+   std::vector<input_benchmarks> parsed(inputs.size());
+   auto render = [&](const gb2gc::manifest::chart& chart)
+   {
+      std::vector<const input_benchmarks*> chart_inputs;
+      std::vector<std::string> files;
+      for (auto i : chart.inputs)
+      {
+         chart_inputs.emplace_back(&parsed[i]);
+         files.emplace_back(inputs[i]);
+      }
+      write_output(chart.options, chart_inputs, files);
+   };
+
+   gb2gc::thread_pool pool;
+   pool.parallel_for(inputs.size(), [&](std::size_t i)
+   {
+      read_input(inputs[i], std::vector<std::string>(),
+         gb2gc::benchmark_filter(), use_snapshot[i] != 0, parsed[i]);
+
+      // Render the charts for which this was the last input. The charts are
+      // queued on this worker from which idle workers steal them.
+      std::vector<std::size_t> ready;
+      for (auto c : waiting[i])
+      {
+         if (--remaining[c] == 0)
+            ready.emplace_back(c);
+      }
+      pool.parallel_for(ready.size(), [&](std::size_t r) { render(charts[ready[r]]); });
+   });
+   return 0; // success
+}
+
+// Hash of a sequence of tokens
+struct tokens_hash
+{
+   std::size_t operator()(const std::vector<gb2gc::token_id>& tokens) const noexcept
+   {
+      std::size_t h = tokens.size();
+      for (auto token : tokens)
+         h ^= token + 0x9e3779b9u + (h << 6) + (h >> 2);
+      return h;
+   }
+};
+
+// Typed key value used to assign benchmarks to data set rows
+struct key_value
+{
+   gb2gc::extracted_column::cell type;
+   std::uint64_t                 bits; // double bits or token id
+
+   bool operator==(const key_value& other) const noexcept
+   {
+      return type == other.type && bits == other.bits;
+   }
+};
+
+struct key_value_hash
+{
+   std::size_t operator()(const key_value& k) const noexcept
+   {
+      return std::hash<std::uint64_t>()(k.bits) ^ static_cast<std::size_t>(k.type);
+   }
+};
+
+key_value make_key_value(const gb2gc::extracted_column& column, std::size_t pos)
+{
+   key_value k{ column.cells[pos], 0 };
+   if (k.type == gb2gc::extracted_column::cell::number)
+   {
+      // Normalize zero so that -0.0 and 0.0 are the same key
+      const auto number = column.numbers[pos] == 0.0 ? 0.0 : column.numbers[pos];
+      std::memcpy(&k.bits, &number, sizeof(number));
+   }
+   else if (k.type == gb2gc::extracted_column::cell::token)
+   {
+      k.bits = column.tokens[pos];
+   }
+   return k;
 }
 
-series_object make_series(const nlohmann::json::const_iterator bm_begin,
-   const nlohmann::json::const_iterator bm_end,
+series_object make_series(const gb2gc::benchmark_table& benchmarks,
+   gb2gc::tokenized_names& names,
    const std::vector<gb2gc::selector>& selectors,
-   const std::string& filter)
+   const gb2gc::benchmark_filter& filter)
 {
    series_object so;
 
-   std::vector<std::string> filter_splits = gb2gc::split(filter, '/');
-
-   std::string row;
-   for (auto it = bm_begin; it != bm_end; ++it)
+   // Wildcard token, interned so that a benchmark name token '*' is treated
+   // the same as a wildcard just like when comparing strings
+   auto& table = names.table();
+   const auto any = table.intern("*");
+
+   // Index of series key, i.e. name tokens with selected parameter replaced
+   // by a wildcard, to position in so.series which allows grouping benchmarks
+   // in a single pass while preserving the order in which series are first
+   // encountered.
+   std::unordered_map<std::vector<gb2gc::token_id>, std::size_t, tokens_hash> index;
+
+   // Aggregates reported by Google Benchmark are not repetitions and
+   // would be aggregated as such
+   const auto skip_aggregates = is_aggregated(selectors);
+   const auto name_field = benchmarks.field("name");
+   const auto run_type = skip_aggregates ? benchmarks.field("run_type") : gb2gc::benchmark_table::npos;
+
+   std::vector<gb2gc::token_id> key;
+   for (auto bm = std::size_t(0); bm < names.size(); ++bm)
    {
-      if (!accept(it, filter_splits))
+      if (!accept(benchmarks, name_field, bm, filter))
+         continue;
+      if (skip_aggregates && is_aggregate(benchmarks, run_type, bm))
          continue;
 
-      for (auto s : selectors)
+      const auto tokens = names.begin(bm);
+      const auto count = names.count(bm);
+      for (const auto& s : selectors)
       {
          if (s.is_parameterized())
          {
-            const auto splits = split_attribute(it, "name");
-            for (auto i = 0u; i < splits.size(); ++i)
-            {
-               //if (s.param_index() == i)
-               //{
-               //	continue;
-               //}
-
-               if (!row.empty())
-                  row += "/";
-               if (s.param_index() == i)
-                  row += "*";
-               else
-                  row += std::move(splits[i]);
-            }
+            for (auto i = 0u; i < count; ++i)
+               key.emplace_back(s.param_index() == i ? any : tokens[i]);
          }
       }
 
-      auto sit = std::find_if(so.series.begin(), so.series.end(),
-         [&](const series& s) { return s.name == row; });
-      if (sit == so.series.end())
+      const auto found = index.find(key);
+      if (found == index.end())
       {
-         so.series.emplace_back(series{ row, std::vector<nlohmann::json::const_iterator>({ it }) });
-         //so.series.emplace_back(std::make_pair(
-         //	row, std::vector<nlohmann::json::const_iterator>({ it })));
+         std::string name;
+         for (auto token : key)
+         {
+            if (!name.empty())
+               name += "/";
+            name += table.str(token);
+         }
+         index.emplace(key, so.series.size());
+         so.series.emplace_back(series{ std::move(name), std::vector<std::size_t>({ bm }) });
       }
       else
       {
-         sit->benchmarks.emplace_back(it);
+         so.series[found->second].benchmarks.emplace_back(bm);
       }
 
-      //auto sit = so.s2bm.find(row);
-      //if (so.s2bm.find(row) == so.s2bm.end())
-      //{
-      //	so.s2bm.insert(std::make_pair(
-      //		row, std::vector<nlohmann::json::const_iterator>({ it })));
-      //}
-      //else
-      //{
-      //	sit->second.emplace_back(it);
-      //}
-
-      // Clear row string for next iteration
-      row.clear();
+      // Clear key for next iteration
+      key.clear();
    }
 
    return so;
@@ -189,14 +570,18 @@ series_object make_series(const nlohmann::json::const_iterator bm_begin,
 
 gb2gc::data_set gb2gc::parse_data(const options& options, const nlohmann::json& bm_result)
 {
-   gb2gc::data_set ds;
-
    auto benchmarks = bm_result.find("benchmarks");
    if (benchmarks == bm_result.end())
    {
       std::cerr << "Error: Could not find 'benchmarks' element in given JSON source.\n";
-      return ds; // TODO Exception
+      return gb2gc::data_set(); // TODO Exception
    }
+   return parse_data(options, json_benchmark_table(*benchmarks));
+}
+
+gb2gc::data_set gb2gc::parse_data(const options& options, const benchmark_table& benchmarks)
+{
+   gb2gc::data_set ds;
 
    // Get selectors from options or populate with default selectors if not specified
    const std::vector<selector>& selectors = options.selectors();
@@ -211,62 +596,139 @@ gb2gc::data_set gb2gc::parse_data(const options& options, const nlohmann::json&
    // This basically creates a map of {series, benchmarks} based on set of
    // selectors where each unique name makes an individual key using name selectors
    // as wildcards for pattern matching.
-   auto so = make_series(benchmarks->begin(), benchmarks->end(), selectors, options.filter());
-
-   // Use selectors to create columns in data set representing series
-   // and extract all distinct key values from series benchmarks and resize
-   // the data set based on number of rows
-   std::vector<gb2gc::variant> distinct_key_values;
+   // Tokenize benchmark names once, all further name handling is done on
+   // token ids.
+   const auto name_field = benchmarks.field("name");
+   gb2gc::tokenized_names names;
+   for (auto bm = std::size_t(0); bm < benchmarks.size(); ++bm)
+   {
+      const auto value = attribute(benchmarks, name_field, bm, "name");
+      names.add(value.data, value.size);
+   }
+   auto so = make_series(benchmarks, names, selectors, options.filter());
+
+   // Extract selected values of all series benchmarks in a single pass
+   // with the benchmarks of each series at consecutive positions
+   std::vector<std::size_t> order;
+   for (const auto& series : so.series)
+      order.insert(order.end(), series.benchmarks.begin(), series.benchmarks.end());
+   const auto columns = gb2gc::column_extractor(selectors).extract(benchmarks, names, order);
+   const auto& table = names.table();
+
+   // Use selectors to create columns in data set representing series.
+   // Each distinct key value is assigned a row in order of first appearance
+   // and the row of each benchmark is recorded for assembling rows below.
+   const auto& keys = columns[0];
+   std::vector<std::size_t> distinct_keys;  // position of first benchmark with key
+   std::unordered_map<key_value, std::size_t, key_value_hash> key_rows;
+   std::vector<std::size_t> rows(order.size());
    ds.add_column("Key");
-   for (auto& series : so.series)
+   for (const auto& series : so.series)
    {
       for (auto i = 1u; i < selectors.size(); ++i)
       {
-         ds.add_column(series.name + " " + selectors[i].key());
-      }
-
-      for (auto& bm : series.benchmarks)
-      {
-         auto key_value = selectors[0](*bm);
-         if (std::find(distinct_key_values.begin(), distinct_key_values.end(), key_value) == distinct_key_values.end())
-            distinct_key_values.emplace_back(key_value);
+         if (selectors[i].is_aggregated())
+            ds.add_column(series.name + " " + selectors[i].key() + " " + 
+               selectors[i].aggregation().name());
+         else
+            ds.add_column(series.name + " " + selectors[i].key());
       }
    }
-   //std::sort(distinct_key_values.begin(), distinct_key_values.end());
-   ds.resize_rows(distinct_key_values.size());
-
-   for (auto row_index = 0u; row_index < distinct_key_values.size(); ++row_index)
+   for (auto pos = std::size_t(0); pos < order.size(); ++pos)
    {
-      // Insert key (x) value
-      ds.get_col(0)[row_index] = distinct_key_values[row_index];
-
-      // Insert other values
-      auto column_index = 1u;
-      for (auto& series : so.series)
+      const auto found = key_rows.emplace(make_key_value(keys, pos), distinct_keys.size());
+      if (found.second)
+         distinct_keys.emplace_back(pos);
+      rows[pos] = found.first->second;
+   }
+   ds.resize_rows(distinct_keys.size());
+
+   // Insert key (x) values
+   for (auto row_index = 0u; row_index < distinct_keys.size(); ++row_index)
+      ds.get_col(0)[row_index] = keys.value(distinct_keys[row_index], table);
+
+   // Insert other values, if a series has multiple benchmarks with the same
+   // key value these are aggregated, by default the first one is used
+   std::vector<std::size_t> group_first; // first grouped position of each row
+   std::vector<std::size_t> grouped;     // positions of series grouped by row
+   std::vector<double> values;
+   auto column_index = 1u;
+   auto pos = std::size_t(0);
+   for (const auto& series : so.series)
+   {
+      // Group benchmark positions by row preserving their order
+      const auto first = pos;
+      const auto last = pos + series.benchmarks.size();
+      group_first.assign(ds.rows() + 1, 0);
+      for (pos = first; pos != last; ++pos)
+         ++group_first[rows[pos] + 1];
+      for (auto row_index = std::size_t(0); row_index < ds.rows(); ++row_index)
+         group_first[row_index + 1] += group_first[row_index];
+      grouped.resize(series.benchmarks.size());
+      auto next = group_first;
+      for (pos = first; pos != last; ++pos)
+         grouped[next[rows[pos]]++] = pos;
+
+      for (auto row_index = std::size_t(0); row_index < ds.rows(); ++row_index)
       {
-         // Find benchmark corresponding to current row
-         auto find = std::find_if(series.benchmarks.begin(), series.benchmarks.end(),
-            [&](const nlohmann::json::const_iterator& it)
-         {
-            return selectors[0](*it) == distinct_key_values[row_index];
-         });
-         if (find == series.benchmarks.end())
-            continue; // TODO Handle
+         const auto group_begin = grouped.begin() + static_cast<std::ptrdiff_t>(group_first[row_index]);
+         const auto group_end = grouped.begin() + static_cast<std::ptrdiff_t>(group_first[row_index + 1]);
+         if (group_begin == group_end)
+            continue;
 
-         for (auto i = 1u; i < selectors.size(); ++i)
+         for (auto j = 1u; j < selectors.size(); ++j)
          {
-            ds.get_col(column_index)[row_index] = selectors[i](*(*find));
-            ++column_index;
+            auto cell = ds.get_col(column_index + j - 1)[row_index];
+            if (!selectors[j].is_aggregated())
+            {
+               cell = columns[j].value(*group_begin, table);
+               continue;
+            }
+
+            values.clear();
+            for (auto it = group_begin; it != group_end; ++it)
+            {
+               if (columns[j].cells[*it] == gb2gc::extracted_column::cell::number)
+                  values.emplace_back(columns[j].numbers[*it]);
+            }
+            if (!values.empty())
+               cell = gb2gc::variant(selectors[j].aggregation()(values));
          }
       }
+      column_index += static_cast<unsigned>(selectors.size() - 1);
    }
 
+   // Order rows by numeric key values, string keys keep the order of first
+   // appearance
+   const auto key_storage = ds.get_col(0).storage_type();
+   if (key_storage == gb2gc::data_set::column_type::storage::integer ||
+       key_storage == gb2gc::data_set::column_type::storage::floating)
+      ds.sort(0);
+
    return ds;
 }
 
-void gb2gc::write_chart(const options& options, const gb2gc::data_set& data_set)
+// Returns the id of the div holding the chart derived from the output file
+std::string chart_div(const gb2gc::options& options)
+{
+   std::string div = options.out_file();
+   if (div == "-")
+   {  // standard output has no file name to derive the div from
+      div = "chart_div";
+   }
+   else
+   {
+      std::replace(div.begin(), div.end(), '\\', '/');
+      auto path_splits = gb2gc::split(div, '/');
+      auto filename_splits = gb2gc::split(path_splits[path_splits.size() - 1], '.');
+      div = filename_splits[0] + "_div";
+   }
+   return div;
+}
+
+// Returns the chart configured by the given options
+gb2gc::googlechart make_chart(const gb2gc::options& options)
 {
-   // Generate chart
    gb2gc::googlechart gc;
    gc.options = options.chart_options();
    gc.type = options.chart_type();
@@ -274,15 +736,84 @@ void gb2gc::write_chart(const options& options, const gb2gc::data_set& data_set)
    // Google chart swaps axes for bar chart
    if (options.chart_type() == gb2gc::googlechart::visualization::bar)
       std::swap(gc.options.vertical_axis, gc.options.horizontal_axis);
+   return gc;
+}
+
+// Returns the name of the series of the given column, i.e. the column name
+// without the selector key suffix
+std::string series_name(const gb2gc::options& options, const std::string& column)
+{
+   const auto& selector = options.selectors()[1];
+   auto suffix = " " + selector.key();
+   if (selector.is_aggregated())
+      suffix += " " + selector.aggregation().name();
+   if (column.size() >= suffix.size() &&
+       column.compare(column.size() - suffix.size(), suffix.size(), suffix) == 0)
+      return column.substr(0, column.size() - suffix.size());
+   return column;
+}
+
+void gb2gc::write_chart(const options& options, const gb2gc::data_set& data_set)
+{
+   write_chart(options, gb2gc::data_set_view(data_set));
+}
+
+void gb2gc::write_chart(const options& options, const gb2gc::data_set_view& view)
+{
+   auto dom_options = options.dom_options();
+   dom_options.div = chart_div(options);
+   make_chart(options).write_html_file(options.out_file().c_str(), view, dom_options);
+}
 
-   gb2gc::googlechart_dom_options dom_options = options.dom_options();
+void gb2gc::write_dashboard(const options& options, const gb2gc::data_set_view& view)
+{
+   // One chart per series, each projecting the key column and the columns
+   // of the series restricted to the rows where the series has values
+   const auto series_cols = options.selectors().size() - 1;
+   const auto base = options.chart_options();
+   const auto div = chart_div(options);
+   gb2gc::googlechart_dashboard dashboard;
+   for (auto first = std::size_t(1); first + series_cols <= view.cols(); first += series_cols)
+   {
+      gb2gc::googlechart_dashboard::chart chart;
+      chart.gc = make_chart(options);
+      const auto name = series_name(options, view.get_col(first).name());
+      auto& title = chart.gc.options.title;
+      title = base.title.empty() ? name : base.title + " - " + name;
+      chart.dom_options = options.dom_options();
+      chart.dom_options.div = div + std::to_string(dashboard.charts.size());
+
+      chart.columns.emplace_back(0);
+      for (auto col = first; col != first + series_cols; ++col)
+         chart.columns.emplace_back(col);
+      for (auto row = std::size_t(0); row < view.rows(); ++row)
+      {
+         const auto index = view.row_index(row);
+         for (auto col = first; col != first + series_cols; ++col)
+         {
+            if (!view.get_col(col).is_null(index))
+            {
+               chart.rows.emplace_back(row);
+               break;
+            }
+         }
+      }
+      if (chart.rows.size() == view.rows())
+         chart.rows.clear(); // all rows
 
-   std::string chart_div = options.out_file();
-   std::replace(chart_div.begin(), chart_div.end(), '\\', '/');
-   auto path_splits = split(chart_div, '/');
-   auto filename_splits = split(path_splits[path_splits.size() - 1], '.');
-   chart_div = filename_splits[0] + "_div";
-   dom_options.div = chart_div;
+      dashboard.charts.emplace_back(std::move(chart));
+   }
+   dashboard.write_html_file(options.out_file().c_str(), view, options.dom_options());
+}
 
-   gc.write_html_file(options.out_file().c_str(), data_set, dom_options);
+void gb2gc::write_svg_chart(const options& options, const gb2gc::data_set_view& view)
+{
+   const auto gc = make_chart(options);
+   gb2gc::svgchart chart;
+   chart.options = gc.options;
+   chart.type = gc.type;
+   chart.width = options.dom_options().width;
+   chart.height = options.dom_options().height;
+   const auto fmt = options.dom_options().compact ? gb2gc::format::minified() : gb2gc::format();
+   chart.write_svg_file(options.out_file().c_str(), view, fmt);
 }
@@ -14,10 +14,16 @@
 
 #include <nlohmann/json.hpp>
 
+#include "aggregate.h"
+#include "benchmark_table.h"
 #include "chart.h"
+#include "filter.h"
+#include "token_table.h"
 
 namespace gb2gc
 {
+   class manifest;
+
    static constexpr int ERROR_NO_ERROR = 0;
    static constexpr int ERROR_INVALID_ARGUMENT = 1;
 
@@ -56,6 +62,8 @@ namespace gb2gc
       // Constructs a selector that selects data with a regular key or of the form
       // 'BM_Identifier/<index>' where 'BM_Identifier' is the name of the benchmark
       // and <index> is the index of the benchmark parameter to be selected.
+      // A key may be suffixed with ':<aggregate>', e.g. 'real_time:median', to
+      // aggregate the values of repeated benchmarks.
       selector(const std::string& key);
 
       // Selects data from the given benchmark
@@ -68,9 +76,14 @@ namespace gb2gc
       // i.e. is_parameterized() returns true, else is undefined behavior.
       unsigned param_index() const;
 
+      // Returns true if values of repeated benchmarks are aggregated
+      bool is_aggregated() const;
+      const gb2gc::aggregate& aggregation() const;
+
    private:
       std::string key_;
       unsigned param_index_;
+      gb2gc::aggregate aggregate_;
    };
 
    // Provides the means of parsing and reading command-line options.
@@ -80,11 +93,33 @@ namespace gb2gc
       options();
       int parse(int argc, const char* argv[]);
 
+      // Returns the first input file
       const std::string& in_file() const;
+
+      // Returns all input files with any wildcard patterns expanded
+      const std::vector<std::string>& in_files() const;
       const std::string& out_file() const;
 
+      // Returns true if a binary snapshot of the parsed input should be
+      // written next to the input file and reused by later invocations.
+      bool snapshot() const;
+
+      // Returns the maximum number of points drawn per series, 0 if series
+      // are not downsampled
+      unsigned max_points() const;
+
+      // Returns true if a dashboard with one chart per series is written
+      bool dashboard() const;
+
+      // Returns true if the chart is rendered as static SVG
+      bool svg() const;
+
+      // Returns the manifest file listing charts to be generated in a batch,
+      // empty if a single chart is generated from the other options
+      const std::string& manifest() const;
+
       bool has_filter() const;
-      const std::string& filter() const;
+      const gb2gc::benchmark_filter& filter() const;
 
       const gb2gc::googlechart_dom_options& dom_options() const;
       const gb2gc::googlechart_options& chart_options() const;
@@ -98,13 +133,19 @@ namespace gb2gc
       int parse_size(unsigned& dst, const char* arg);
       int parse_chart_type(const char* arg);
       int parse_legend(const char* arg);
-      int parse_filter(const char* arg);
+      int parse_filter(const span<const char*>& args);
       int parse_selector(const span<const char*>& args);
+      int parse_in_files(const span<const char*>& args);
 
-      std::string in_file_;
+      std::vector<std::string> in_files_;
       std::string out_file_;
 
-      std::string filter_;
+      gb2gc::benchmark_filter filter_;
+      bool snapshot_;
+      unsigned max_points_;
+      bool dashboard_;
+      bool svg_;
+      std::string manifest_;
 
       gb2gc::googlechart_options gc_options_;
       gb2gc::googlechart_dom_options gc_dom_options_;
@@ -115,17 +156,41 @@ namespace gb2gc
 
    // Based on given options, parses and formats the benchmark into chart-compatible data-set
    gb2gc::data_set parse_data(const options& options, const nlohmann::json& bm_result);
+   gb2gc::data_set parse_data(const options& options, const benchmark_table& benchmarks);
 
    // Writes the given data-set as a chart based on given options 
    void write_chart(const options& options, const gb2gc::data_set& data_set);
+   void write_chart(const options& options, const gb2gc::data_set_view& view);
+
+   // Writes the given data-set as a dashboard page with one chart per series
+   // sharing a single embedded data table
+   void write_dashboard(const options& options, const gb2gc::data_set_view& view);
+
+   // Writes the given data-set as a static SVG chart based on given options
+   void write_svg_chart(const options& options, const gb2gc::data_set_view& view);
 
-   // Parses a google benchmark data file
+   // Parses a google benchmark data file retaining all benchmark fields
    nlohmann::json parse_json(const std::string& file);
 
+   // Parses a google benchmark data file retaining only the benchmarks and
+   // benchmark fields required by the given options
+   nlohmann::json parse_json(const std::string& file, const options& options);
+
+   // Parses the given google benchmark data files in parallel and merges the
+   // result in the given order. Each benchmark is tagged with the path of the
+   // file it originates from in the 'input_file' field.
+   nlohmann::json parse_json(const std::vector<std::string>& files, const options& options);
+
    // Runs the Google benchmark converter based on command-line arguments and returns
    // a system-specific error code.
    int run(int argc, const char* argv[]);
 
+   // Generates all charts of the given manifest. Each distinct input file is
+   // parsed once and charts are rendered on a work-stealing thread pool as
+   // soon as all of their inputs have been parsed. Returns a system-specific
+   // error code.
+   int run(const manifest& manifest);
+
 } // namespace gb2gc
 
 #endif // GB2GC_GB2GC_H
\ No newline at end of file
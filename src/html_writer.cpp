@@ -0,0 +1,132 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "html_writer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// Indentation formatting
+
+std::ostream& gb2gc::operator<<(std::ostream& os, const indent& ind)
+{
+   static const char spaces[] = "                                ";
+   auto cnt = ind.level * ind.fmt.indentation;
+   while (cnt != 0)
+   {
+      const auto n = (std::min)(cnt, sizeof(spaces) - 1);
+      os.write(spaces, static_cast<std::streamsize>(n));
+      cnt -= n;
+   }
+   return os;
+}
+
+gb2gc::output_sink& gb2gc::operator<<(output_sink& sink, const indent& ind)
+{
+   sink.indent(ind.level * ind.fmt.indentation);
+   return sink;
+}
+
+// HTML writer
+
+gb2gc::html_writer::html_writer(output_sink& sink, const format& fmt,
+   size_t level)
+   : sink_(sink)
+   , fmt_(fmt)
+   , level_(level)
+   , open_()
+   , start_tag_(false)
+{ }
+
+gb2gc::html_writer& gb2gc::html_writer::open(const std::string& name)
+{
+   if (!open_.empty())
+      begin_content();
+   sink_ << fmt_.indent(level_ + open_.size()) << '<' << name;
+   open_.push_back(name);
+   start_tag_ = true;
+   return *this;
+}
+
+gb2gc::html_writer&
+gb2gc::html_writer::attr(const std::string& name, const std::string& value)
+{
+   if (!start_tag_)
+      throw std::logic_error("attribute '" + name + "' written after element content");
+   sink_ << ' ' << name << "=\"" << value << '"';
+   return *this;
+}
+
+gb2gc::html_writer& gb2gc::html_writer::comment(const std::string& text)
+{
+   if (fmt_.strip_comments)
+      return *this;
+   if (!open_.empty())
+      begin_content();
+   sink_ << fmt_.indent(level_ + open_.size()) << "<!-- " << text << " -->" << fmt_.line_break();
+   return *this;
+}
+
+gb2gc::html_writer& gb2gc::html_writer::text(const std::string& content)
+{
+   begin_content();
+   const auto ind = fmt_.indent(level_ + open_.size());
+   auto first = std::string::size_type(0);
+   while (first < content.size())
+   {
+      auto last = content.find('\n', first);
+      if (last == std::string::npos)
+         last = content.size();
+      sink_ << ind;
+      sink_.append(content.data() + first, last - first);
+      sink_ << '\n';
+      first = last + 1;
+   }
+   return *this;
+}
+
+gb2gc::html_writer& gb2gc::html_writer::inline_text(const std::string& content)
+{
+   if (!start_tag_)
+      throw std::logic_error("inline text written after element content");
+   sink_ << '>' << content << "</" << open_.back() << '>' << fmt_.line_break();
+   start_tag_ = false;
+   open_.pop_back();
+   return *this;
+}
+
+gb2gc::html_writer& gb2gc::html_writer::close()
+{
+   if (open_.empty())
+      throw std::logic_error("no open element to close");
+   if (start_tag_)
+   {  // element without children or content is written on a single line
+      sink_ << "></" << open_.back() << '>' << fmt_.line_break();
+      start_tag_ = false;
+   }
+   else
+   {
+      sink_ << fmt_.indent(level_ + open_.size() - 1)
+         << "</" << open_.back() << '>' << fmt_.line_break();
+   }
+   open_.pop_back();
+   return *this;
+}
+
+void gb2gc::html_writer::close_all()
+{
+   while (!open_.empty())
+      close();
+}
+
+void gb2gc::html_writer::begin_content()
+{
+   if (open_.empty())
+      throw std::logic_error("content written outside of an element");
+   if (start_tag_)
+   {
+      sink_ << '>' << fmt_.line_break();
+      start_tag_ = false;
+   }
+}
@@ -0,0 +1,125 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_HTML_WRITER_H
+#define GB2GC_HTML_WRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "output_sink.h"
+
+namespace gb2gc {
+
+struct format;
+
+struct indent
+{
+    const format& fmt;
+    size_t        level;
+};
+
+std::ostream& operator<<(std::ostream& os, const indent& ind);
+output_sink& operator<<(output_sink& sink, const indent& ind);
+
+struct format
+{
+    bool     strip_comments = false;
+    unsigned indentation    = 2;
+    bool     compact        = false; // omit line breaks and optional spaces
+
+    inline ::gb2gc::indent indent(size_t level) const
+    {
+        return ::gb2gc::indent{ *this, level };
+    }
+
+    inline const char* line_break() const
+    {
+        return compact ? "" : "\n";
+    }
+
+    // Returns the densest format without indentation, comments or line
+    // breaks between elements and statements
+    static format minified()
+    {
+        format fmt;
+        fmt.strip_comments = true;
+        fmt.indentation = 0;
+        fmt.compact = true;
+        return fmt;
+    }
+};
+
+// Streaming HTML writer, elements are written to the sink as they are opened
+// and closed without building a document tree. Elements without children or
+// content are written on a single line, otherwise children and content are
+// written on separate lines indented one level deeper than their parent.
+// Line breaks between elements are omitted with a compact format, while
+// line breaks within text content are kept.
+class html_writer final
+{
+public:
+    explicit html_writer(output_sink& sink, const format& fmt = format(),
+        size_t level = 0);
+
+    html_writer(const html_writer&) = delete;
+    html_writer& operator=(const html_writer&) = delete;
+
+    // Opens a child element of the current element
+    html_writer& open(const std::string& name);
+
+    // Adds an attribute to the element just opened. Throws std::logic_error
+    // if children or content have already been written.
+    html_writer& attr(const std::string& name, const std::string& value);
+
+    // Writes a comment preceding the next element unless comments are stripped
+    html_writer& comment(const std::string& text);
+
+    // Writes text content, each line indented
+    html_writer& text(const std::string& content);
+
+    // Writes single line text content on the line of the element just opened,
+    // which is closed. Throws std::logic_error if children or content have
+    // already been written.
+    html_writer& inline_text(const std::string& content);
+
+    // Writes content generated by the given function object invoked as
+    // write(sink, fmt, level)
+    template<class Writer>
+    html_writer& content(Writer&& write)
+    {
+        begin_content();
+        write(sink_, fmt_, level_ + open_.size());
+        sink_ << fmt_.line_break();
+        return *this;
+    }
+
+    // Closes the current element. Throws std::logic_error if no element is
+    // open.
+    html_writer& close();
+
+    // Closes all open elements
+    void close_all();
+
+    // Returns the number of open elements
+    size_t depth() const noexcept { return open_.size(); }
+
+private:
+    void begin_content();
+
+    output_sink&             sink_;
+    format                   fmt_;  // copied, may be a temporary
+    size_t                   level_;
+    std::vector<std::string> open_;
+    bool                     start_tag_;
+};
+
+} // namespace gb2gc
+
+#endif // GB2GC_HTML_WRITER_H
@@ -0,0 +1,195 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "manifest.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+   // Manifest chart key and the command-line option it maps to
+   struct manifest_key
+   {
+      const char* key;
+      const char* option;
+      bool        is_flag;  // boolean key mapping to an option without arguments
+   };
+
+   const manifest_key manifest_keys[] =
+   {
+      { "input",      "-i",           false },
+      { "output",     "-o",           false },
+      { "type",       "-c",           false },
+      { "title",      "-t",           false },
+      { "width",      "-w",           false },
+      { "height",     "-h",           false },
+      { "legend",     "-l",           false },
+      { "xaxis",      "-x",           false },
+      { "yaxis",      "-y",           false },
+      { "select",     "-s",           false },
+      { "filter",     "-f",           false },
+      { "max_points", "--max-points", false },
+      { "snapshot",   "--snapshot",   true },
+      { "compact",    "--compact",    true },
+      { "dashboard",  "--dashboard",  true },
+      { "svg",        "--svg",        true }
+   };
+
+   // Appends the given string, number or array of such as arguments
+   void append_values(std::vector<std::string>& args, const std::string& key,
+      const nlohmann::json& value)
+   {
+      if (value.is_array())
+      {
+         if (value.empty())
+            throw std::invalid_argument("Chart key '" + key + "' may not be empty");
+         for (const auto& v : value)
+         {
+            if (v.is_array())
+               throw std::invalid_argument("Chart key '" + key + "' may not contain arrays");
+            append_values(args, key, v);
+         }
+      }
+      else if (value.is_string())
+         args.emplace_back(value.get<std::string>());
+      else if (value.is_number_unsigned())
+         args.emplace_back(std::to_string(value.get<unsigned long long>()));
+      else
+         throw std::invalid_argument("Chart key '" + key + "' must be a string, unsigned number or array");
+   }
+}
+
+std::vector<std::string> gb2gc::manifest_args(const nlohmann::json& chart)
+{
+   if (!chart.is_object())
+      throw std::invalid_argument("Chart must be an object");
+
+   // Keys are processed in table order rather than the (unspecified) order of
+   // the object to get a deterministic command-line
+   std::vector<std::string> args;
+   for (const auto& k : manifest_keys)
+   {
+      const auto value = chart.find(k.key);
+      if (value == chart.end())
+         continue;
+      if (!k.is_flag)
+      {
+         args.emplace_back(k.option);
+         append_values(args, k.key, *value);
+      }
+      else if (!value->is_boolean())
+         throw std::invalid_argument("Chart key '" + std::string(k.key) + "' must be a boolean");
+      else if (value->get<bool>())
+         args.emplace_back(k.option);
+   }
+
+   const auto extra = chart.find("args");
+   if (extra != chart.end())
+   {
+      if (!extra->is_array())
+         throw std::invalid_argument("Chart key 'args' must be an array");
+      append_values(args, "args", *extra);
+   }
+
+   for (auto it = chart.begin(); it != chart.end(); ++it)
+   {
+      const auto known = std::any_of(std::begin(manifest_keys), std::end(manifest_keys),
+         [&](const manifest_key& k) { return it.key() == k.key; });
+      if (!known && it.key() != "args")
+         throw std::invalid_argument("Unknown chart key '" + it.key() + "'");
+   }
+   return args;
+}
+
+int gb2gc::manifest::read(const std::string& file)
+{
+   std::ifstream stream(file);
+   if (!stream)
+      return show_error("Could not open manifest file '" + file + "'");
+
+   nlohmann::json json;
+   try
+   {
+      json = nlohmann::json::parse(stream);
+   }
+   catch (const nlohmann::json::parse_error& e)
+   {
+      return show_error("Invalid manifest '" + file + "': " + e.what());
+   }
+   return parse(json, file);
+}
+
+int gb2gc::manifest::parse(const nlohmann::json& manifest, const std::string& name)
+{
+   charts_.clear();
+   inputs_.clear();
+
+   const auto charts = manifest.find("charts");
+   if (!manifest.is_object() || charts == manifest.end() || !charts->is_array())
+      return show_error("Could not find 'charts' array in manifest '" + name + "'");
+
+   std::vector<std::string> outputs;
+   for (auto i = std::size_t(0); i < charts->size(); ++i)
+   {
+      const auto where = "chart " + std::to_string(i) + " of manifest '" + name + "'";
+
+      chart c;
+      try
+      {
+         c.args = manifest_args((*charts)[i]);
+      }
+      catch (const std::invalid_argument& e)
+      {
+         return show_error(std::string(e.what()) + " in " + where);
+      }
+
+      std::vector<const char*> argv({ "gb2gc" });
+      for (const auto& arg : c.args)
+         argv.emplace_back(arg.c_str());
+      const auto err = c.options.parse(static_cast<int>(argv.size()), argv.data());
+      if (err)
+      {
+         std::cerr << "Error: Invalid " << where << "\n";
+         return err;
+      }
+      if (!c.options.manifest().empty())
+         return show_error("Manifests may not be nested in " + where);
+
+      // Charts are written concurrently and may therefore not share output
+      const auto& out = c.options.out_file();
+      if (std::find(outputs.begin(), outputs.end(), out) != outputs.end())
+         return show_error("Output '" + out + "' is written by more than one chart in manifest '" + name + "'");
+      outputs.emplace_back(out);
+
+      for (const auto& file : c.options.in_files())
+      {
+         auto input = std::find(inputs_.begin(), inputs_.end(), file);
+         if (input == inputs_.end())
+            input = inputs_.insert(inputs_.end(), file);
+         c.inputs.emplace_back(static_cast<std::size_t>(input - inputs_.begin()));
+      }
+      charts_.emplace_back(std::move(c));
+   }
+   return ERROR_NO_ERROR;
+}
+
+const std::vector<gb2gc::manifest::chart>& gb2gc::manifest::charts() const noexcept
+{
+   return charts_;
+}
+
+const std::vector<std::string>& gb2gc::manifest::inputs() const noexcept
+{
+   return inputs_;
+}
+
+int gb2gc::manifest::show_error(const std::string& message)
+{
+   std::cerr << "Error: " << message << "\n";
+   return ERROR_INVALID_ARGUMENT;
+}
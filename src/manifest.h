@@ -0,0 +1,69 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_MANIFEST_H
+#define GB2GC_MANIFEST_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "gb2gc.h"
+
+namespace gb2gc
+{
+   // Batch of charts read from a JSON manifest listing the inputs and options
+   // of each chart, e.g.
+   //
+   // { "charts": [
+   //    { "input": [ "a.json" ], "output": "a.html", "type": "line" },
+   //    { "input": [ "a.json", "b.json" ], "output": "ab.html", "type": "bar",
+   //      "title": "A and B", "args": [ "--compact" ] } ] }
+   //
+   // Supported chart keys are 'input', 'output', 'type', 'title', 'width',
+   // 'height', 'legend', 'xaxis', 'yaxis', 'select', 'filter', 'max_points',
+   // the booleans 'snapshot', 'compact', 'dashboard' and 'svg', and 'args'
+   // with additional command-line arguments. Relative paths are relative to
+   // the working directory like on the command-line.
+   class manifest final
+   {
+   public:
+      struct chart
+      {
+         std::vector<std::string> args;    // equivalent command-line arguments
+         gb2gc::options           options;
+         std::vector<std::size_t> inputs;  // index into inputs() per input file
+      };
+
+      // Reads the given manifest file. Returns a system-specific error code
+      // if the manifest or any of its charts is invalid.
+      int read(const std::string& file);
+      int parse(const nlohmann::json& manifest, const std::string& name = "manifest");
+
+      const std::vector<chart>& charts() const noexcept;
+
+      // Returns the distinct input files of all charts in order of first use
+      const std::vector<std::string>& inputs() const noexcept;
+
+   private:
+      int show_error(const std::string& message);
+
+      std::vector<chart>       charts_;
+      std::vector<std::string> inputs_;
+   };
+
+   // Converts a manifest chart entry to the equivalent command-line arguments,
+   // excluding the program name. Throws std::invalid_argument if the entry is
+   // invalid.
+   std::vector<std::string> manifest_args(const nlohmann::json& chart);
+
+} // namespace gb2gc
+
+#endif // GB2GC_MANIFEST_H
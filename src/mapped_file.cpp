@@ -0,0 +1,107 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "mapped_file.h"
+
+#include <utility>
+
+#if GB2GC_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+gb2gc::mapped_file::mapped_file() noexcept
+   : data_(nullptr), size_(0)
+{ }
+
+gb2gc::mapped_file::~mapped_file() noexcept
+{
+   close();
+}
+
+gb2gc::mapped_file::mapped_file(mapped_file&& other) noexcept
+   : data_(other.data_), size_(other.size_)
+{
+   other.data_ = nullptr;
+   other.size_ = 0;
+}
+
+gb2gc::mapped_file&
+gb2gc::mapped_file::operator=(mapped_file&& other) noexcept
+{
+   if (this != &other)
+   {
+      close();
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+   }
+   return *this;
+}
+
+bool gb2gc::mapped_file::open(const std::string& path)
+{
+   close();
+#if GB2GC_HAS_MMAP
+   // Opening a pipe blocks until a writer connects and consumes the
+   // connection, hence only regular files may be opened here since callers
+   // fall back to opening the path again for buffered reads
+   struct stat st;
+   if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+      return false;
+
+   const auto fd = ::open(path.c_str(), O_RDONLY);
+   if (fd < 0)
+      return false;
+
+   // The path may have been replaced after the check above
+   if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+   {
+      ::close(fd);
+      return false;
+   }
+
+   const auto size = static_cast<std::size_t>(st.st_size);
+   void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   ::close(fd); // mapping remains valid after closing the descriptor
+   if (addr == MAP_FAILED)
+      return false;
+
+   // Input is consumed front to back exactly once
+   ::madvise(addr, size, MADV_SEQUENTIAL);
+
+   data_ = static_cast<const char*>(addr);
+   size_ = size;
+   return true;
+#else
+   (void)path;
+   return false;
+#endif
+}
+
+void gb2gc::mapped_file::close() noexcept
+{
+#if GB2GC_HAS_MMAP
+   if (data_)
+      ::munmap(const_cast<char*>(data_), size_);
+#endif
+   data_ = nullptr;
+   size_ = 0;
+}
+
+bool gb2gc::mapped_file::is_open() const noexcept
+{
+   return data_ != nullptr;
+}
+
+const char* gb2gc::mapped_file::data() const noexcept
+{
+   return data_;
+}
+
+std::size_t gb2gc::mapped_file::size() const noexcept
+{
+   return size_;
+}
@@ -0,0 +1,54 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_MAPPED_FILE_H
+#define GB2GC_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GB2GC_HAS_MMAP 1
+#else
+#define GB2GC_HAS_MMAP 0
+#endif
+
+namespace gb2gc
+{
+   // Read-only memory mapping of a regular file. Mapping is only supported on
+   // POSIX platforms, on other platforms open() always fails which allows
+   // callers to fall back to regular buffered reads.
+   class mapped_file final
+   {
+   public:
+      mapped_file() noexcept;
+      ~mapped_file() noexcept;
+      mapped_file(const mapped_file&) = delete;
+      mapped_file& operator=(const mapped_file&) = delete;
+      mapped_file(mapped_file&& other) noexcept;
+      mapped_file& operator=(mapped_file&& other) noexcept;
+
+      // Maps the given file into memory. Returns false if the file do not
+      // exist, is not a non-empty regular file (e.g. a pipe) or if mapping
+      // is not supported on this platform. Files other than regular files
+      // are never opened, such that a pipe may still be read by the caller.
+      bool open(const std::string& path);
+      void close() noexcept;
+
+      bool is_open() const noexcept;
+      const char* data() const noexcept;
+      std::size_t size() const noexcept;
+
+   private:
+      const char* data_;
+      std::size_t size_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_MAPPED_FILE_H
@@ -0,0 +1,435 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+// Shortest round-trip floating point formatting based on the Grisu2
+// algorithm by Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers", PLDI 2010. Grisu2 always produces digits that
+// read back as the formatted value and the shortest such digits for the vast
+// majority of values.
+
+#include "number_format.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+   // Floating point value f * 2^e with a 64-bit significand
+   struct diyfp
+   {
+      std::uint64_t f;
+      int           e;
+   };
+
+   diyfp sub(const diyfp& x, const diyfp& y) noexcept
+   {
+      return diyfp{ x.f - y.f, x.e };
+   }
+
+   // Returns x * y rounded to the upper 64 bits of the 128-bit product
+   diyfp mul(const diyfp& x, const diyfp& y) noexcept
+   {
+      const std::uint64_t mask = 0xFFFFFFFFu;
+      const auto a = x.f >> 32;
+      const auto b = x.f & mask;
+      const auto c = y.f >> 32;
+      const auto d = y.f & mask;
+      const auto ac = a * c;
+      const auto bc = b * c;
+      const auto ad = a * d;
+      const auto bd = b * d;
+      auto tmp = (bd >> 32) + (ad & mask) + (bc & mask);
+      tmp += std::uint64_t(1) << 31; // round
+      return diyfp{ ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64 };
+   }
+
+   diyfp normalize(diyfp x) noexcept
+   {
+      while ((x.f >> 63) == 0)
+      {
+         x.f <<= 1;
+         --x.e;
+      }
+      return x;
+   }
+
+   diyfp normalize_to(const diyfp& x, int e) noexcept
+   {
+      return diyfp{ x.f << (x.e - e), e };
+   }
+
+   struct boundaries
+   {
+      diyfp w;
+      diyfp minus;
+      diyfp plus;
+   };
+
+   // Returns the normalized value and the normalized boundaries m- and m+
+   // of the interval of real numbers rounding to the given positive value
+   template<class Float, class Bits>
+   boundaries compute_boundaries(Float value) noexcept
+   {
+      constexpr int precision = std::numeric_limits<Float>::digits;
+      constexpr int bias = std::numeric_limits<Float>::max_exponent - 1 + (precision - 1);
+      constexpr int min_exponent = 1 - bias;
+      constexpr std::uint64_t hidden_bit = std::uint64_t(1) << (precision - 1);
+
+      Bits bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      const auto biased_exponent = static_cast<int>(bits >> (precision - 1));
+      const auto fraction = static_cast<std::uint64_t>(bits) & (hidden_bit - 1);
+
+      const auto v = biased_exponent == 0 ?
+         diyfp{ fraction, min_exponent } :
+         diyfp{ fraction + hidden_bit, biased_exponent - bias };
+
+      // The lower boundary is closer if the significand is a power of two
+      const auto lower_closer = fraction == 0 && biased_exponent > 1;
+      const auto m_plus = diyfp{ 2 * v.f + 1, v.e - 1 };
+      const auto m_minus = lower_closer ?
+         diyfp{ 4 * v.f - 1, v.e - 2 } : diyfp{ 2 * v.f - 1, v.e - 1 };
+
+      const auto w_plus = normalize(m_plus);
+      return boundaries{ normalize(v), normalize_to(m_minus, w_plus.e), w_plus };
+   }
+
+   struct cached_power
+   {
+      std::uint64_t f;
+      int           e;
+      int           k;
+   };
+
+   // Binary exponent range of scaled values, see the paper for details
+   constexpr int alpha = -60;
+   constexpr int gamma = -32;
+
+   // Normalized powers 10^k for k = -300, -292, ..., 324
+   constexpr int cached_powers_min_exponent = -300;
+   constexpr int cached_powers_step = 8;
+
+   // Returns a cached power c = 10^-k such that the binary exponent of the
+   // product of c and a value with exponent e is in [alpha, gamma]
+   cached_power get_cached_power(int e) noexcept
+   {
+      static const cached_power powers[] = {
+         { 0xAB70FE17C79AC6CA, -1060, -300 },
+         { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+         { 0xBE5691EF416BD60C, -1007, -284 },
+         { 0x8DD01FAD907FFC3C,  -980, -276 },
+         { 0xD3515C2831559A83,  -954, -268 },
+         { 0x9D71AC8FADA6C9B5,  -927, -260 },
+         { 0xEA9C227723EE8BCB,  -901, -252 },
+         { 0xAECC49914078536D,  -874, -244 },
+         { 0x823C12795DB6CE57,  -847, -236 },
+         { 0xC21094364DFB5637,  -821, -228 },
+         { 0x9096EA6F3848984F,  -794, -220 },
+         { 0xD77485CB25823AC7,  -768, -212 },
+         { 0xA086CFCD97BF97F4,  -741, -204 },
+         { 0xEF340A98172AACE5,  -715, -196 },
+         { 0xB23867FB2A35B28E,  -688, -188 },
+         { 0x84C8D4DFD2C63F3B,  -661, -180 },
+         { 0xC5DD44271AD3CDBA,  -635, -172 },
+         { 0x936B9FCEBB25C996,  -608, -164 },
+         { 0xDBAC6C247D62A584,  -582, -156 },
+         { 0xA3AB66580D5FDAF6,  -555, -148 },
+         { 0xF3E2F893DEC3F126,  -529, -140 },
+         { 0xB5B5ADA8AAFF80B8,  -502, -132 },
+         { 0x87625F056C7C4A8B,  -475, -124 },
+         { 0xC9BCFF6034C13053,  -449, -116 },
+         { 0x964E858C91BA2655,  -422, -108 },
+         { 0xDFF9772470297EBD,  -396, -100 },
+         { 0xA6DFBD9FB8E5B88F,  -369,  -92 },
+         { 0xF8A95FCF88747D94,  -343,  -84 },
+         { 0xB94470938FA89BCF,  -316,  -76 },
+         { 0x8A08F0F8BF0F156B,  -289,  -68 },
+         { 0xCDB02555653131B6,  -263,  -60 },
+         { 0x993FE2C6D07B7FAC,  -236,  -52 },
+         { 0xE45C10C42A2B3B06,  -210,  -44 },
+         { 0xAA242499697392D3,  -183,  -36 },
+         { 0xFD87B5F28300CA0E,  -157,  -28 },
+         { 0xBCE5086492111AEB,  -130,  -20 },
+         { 0x8CBCCC096F5088CC,  -103,  -12 },
+         { 0xD1B71758E219652C,   -77,   -4 },
+         { 0x9C40000000000000,   -50,    4 },
+         { 0xE8D4A51000000000,   -24,   12 },
+         { 0xAD78EBC5AC620000,     3,   20 },
+         { 0x813F3978F8940984,    30,   28 },
+         { 0xC097CE7BC90715B3,    56,   36 },
+         { 0x8F7E32CE7BEA5C70,    83,   44 },
+         { 0xD5D238A4ABE98068,   109,   52 },
+         { 0x9F4F2726179A2245,   136,   60 },
+         { 0xED63A231D4C4FB27,   162,   68 },
+         { 0xB0DE65388CC8ADA8,   189,   76 },
+         { 0x83C7088E1AAB65DB,   216,   84 },
+         { 0xC45D1DF942711D9A,   242,   92 },
+         { 0x924D692CA61BE758,   269,  100 },
+         { 0xDA01EE641A708DEA,   295,  108 },
+         { 0xA26DA3999AEF774A,   322,  116 },
+         { 0xF209787BB47D6B85,   348,  124 },
+         { 0xB454E4A179DD1877,   375,  132 },
+         { 0x865B86925B9BC5C2,   402,  140 },
+         { 0xC83553C5C8965D3D,   428,  148 },
+         { 0x952AB45CFA97A0B3,   455,  156 },
+         { 0xDE469FBD99A05FE3,   481,  164 },
+         { 0xA59BC234DB398C25,   508,  172 },
+         { 0xF6C69A72A3989F5C,   534,  180 },
+         { 0xB7DCBF5354E9BECE,   561,  188 },
+         { 0x88FCF317F22241E2,   588,  196 },
+         { 0xCC20CE9BD35C78A5,   614,  204 },
+         { 0x98165AF37B2153DF,   641,  212 },
+         { 0xE2A0B5DC971F303A,   667,  220 },
+         { 0xA8D9D1535CE3B396,   694,  228 },
+         { 0xFB9B7CD9A4A7443C,   720,  236 },
+         { 0xBB764C4CA7A44410,   747,  244 },
+         { 0x8BAB8EEFB6409C1A,   774,  252 },
+         { 0xD01FEF10A657842C,   800,  260 },
+         { 0x9B10A4E5E9913129,   827,  268 },
+         { 0xE7109BFBA19C0C9D,   853,  276 },
+         { 0xAC2820D9623BF429,   880,  284 },
+         { 0x80444B5E7AA7CF85,   907,  292 },
+         { 0xBF21E44003ACDD2D,   933,  300 },
+         { 0x8E679C2F5E44FF8F,   960,  308 },
+         { 0xD433179D9C8CB841,   986,  316 },
+         { 0x9E19DB92B4E31BA9,  1013,  324 }
+      };
+
+      const auto f = alpha - e - 1;
+      const auto k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0); // ceil(f * log10(2))
+      const auto index = (-cached_powers_min_exponent + k + (cached_powers_step - 1)) /
+         cached_powers_step;
+      return powers[index];
+   }
+
+   // Returns the number of decimal digits of n and sets pow10 to
+   // 10^(digits - 1)
+   int find_largest_pow10(std::uint32_t n, std::uint32_t& pow10) noexcept
+   {
+      static const std::uint32_t powers[] = { 1u, 10u, 100u, 1000u, 10000u, 100000u,
+         1000000u, 10000000u, 100000000u, 1000000000u };
+      auto digits = 10;
+      while (digits > 1 && n < powers[digits - 1])
+         --digits;
+      pow10 = powers[digits - 1];
+      return digits;
+   }
+
+   // Moves the last digit towards w while it stays within the rounding interval
+   void round_weed(char* buffer, int length, std::uint64_t dist, std::uint64_t delta,
+      std::uint64_t rest, std::uint64_t ten_k) noexcept
+   {
+      while (rest < dist && delta - rest >= ten_k &&
+         (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+      {
+         --buffer[length - 1];
+         rest += ten_k;
+      }
+   }
+
+   // Generates the digits of w within the interval [m_minus, m_plus], the
+   // value written is digits * 10^exponent
+   void generate_digits(char* buffer, int& length, int& exponent,
+      diyfp m_minus, diyfp w, diyfp m_plus) noexcept
+   {
+      auto delta = sub(m_plus, m_minus);
+      auto dist = sub(m_plus, w);
+
+      const diyfp one{ std::uint64_t(1) << -m_plus.e, m_plus.e };
+      auto p1 = static_cast<std::uint32_t>(m_plus.f >> -one.e); // integral part
+      auto p2 = m_plus.f & (one.f - 1);                         // fractional part
+
+      std::uint32_t pow10;
+      auto n = find_largest_pow10(p1, pow10);
+      while (n > 0)
+      {
+         buffer[length++] = static_cast<char>('0' + p1 / pow10);
+         p1 %= pow10;
+         --n;
+
+         const auto rest = (static_cast<std::uint64_t>(p1) << -one.e) + p2;
+         if (rest <= delta.f)
+         {
+            exponent += n;
+            round_weed(buffer, length, dist.f, delta.f, rest,
+               static_cast<std::uint64_t>(pow10) << -one.e);
+            return;
+         }
+         pow10 /= 10;
+      }
+
+      auto m = 0;
+      for (;;)
+      {
+         p2 *= 10;
+         buffer[length++] = static_cast<char>('0' + (p2 >> -one.e));
+         p2 &= one.f - 1;
+         ++m;
+         delta.f *= 10;
+         dist.f *= 10;
+         if (p2 <= delta.f)
+            break;
+      }
+      exponent -= m;
+      round_weed(buffer, length, dist.f, delta.f, p2, one.f);
+   }
+
+   // Writes the shortest digits of a positive finite value to the buffer
+   template<class Float, class Bits>
+   void grisu2(char* buffer, int& length, int& exponent, Float value) noexcept
+   {
+      const auto b = compute_boundaries<Float, Bits>(value);
+      const auto cached = get_cached_power(b.plus.e);
+      const diyfp c{ cached.f, cached.e };
+
+      const auto w = mul(b.w, c);
+      const auto w_minus = mul(b.minus, c);
+      const auto w_plus = mul(b.plus, c);
+
+      // Shrink the interval by one unit in the last place to account for
+      // the rounding of the products
+      length = 0;
+      exponent = -cached.k;
+      generate_digits(buffer, length, exponent,
+         diyfp{ w_minus.f + 1, w_minus.e }, w, diyfp{ w_plus.f - 1, w_plus.e });
+   }
+
+   char* write_exponent(char* out, int e) noexcept
+   {
+      *out++ = 'e';
+      if (e < 0)
+      {
+         *out++ = '-';
+         e = -e;
+      }
+      else
+      {
+         *out++ = '+';
+      }
+      if (e >= 100)
+         *out++ = static_cast<char>('0' + e / 100);
+      if (e >= 10)
+         *out++ = static_cast<char>('0' + e / 10 % 10);
+      *out++ = static_cast<char>('0' + e % 10);
+      return out;
+   }
+
+   // Writes digits * 10^exponent the way JavaScript Number.prototype.toString
+   // does, i.e. fixed notation for decimal point positions in (-6, 21] and
+   // exponential notation otherwise
+   char* write_decimal(char* out, const char* digits, int length, int exponent) noexcept
+   {
+      const auto point = length + exponent; // digits before the decimal point
+      if (length <= point && point <= 21)
+      {
+         std::memcpy(out, digits, static_cast<std::size_t>(length));
+         out += length;
+         for (auto i = length; i < point; ++i)
+            *out++ = '0';
+      }
+      else if (0 < point && point <= 21)
+      {
+         std::memcpy(out, digits, static_cast<std::size_t>(point));
+         out += point;
+         *out++ = '.';
+         std::memcpy(out, digits + point, static_cast<std::size_t>(length - point));
+         out += length - point;
+      }
+      else if (-6 < point && point <= 0)
+      {
+         *out++ = '0';
+         *out++ = '.';
+         for (auto i = point; i < 0; ++i)
+            *out++ = '0';
+         std::memcpy(out, digits, static_cast<std::size_t>(length));
+         out += length;
+      }
+      else
+      {
+         *out++ = digits[0];
+         if (length > 1)
+         {
+            *out++ = '.';
+            std::memcpy(out, digits + 1, static_cast<std::size_t>(length - 1));
+            out += length - 1;
+         }
+         out = write_exponent(out, point - 1);
+      }
+      return out;
+   }
+
+   template<class Float, class Bits>
+   char* format_floating(char* out, Float value) noexcept
+   {
+      if (std::isnan(value))
+      {
+         std::memcpy(out, "NaN", 3);
+         return out + 3;
+      }
+      if (std::signbit(value))
+      {
+         value = -value;
+         if (value != Float(0))
+            *out++ = '-';
+      }
+      if (std::isinf(value))
+      {
+         std::memcpy(out, "Infinity", 8);
+         return out + 8;
+      }
+      if (value == Float(0))
+      {
+         *out++ = '0';
+         return out;
+      }
+
+      char digits[20];
+      int length;
+      int exponent;
+      grisu2<Float, Bits>(digits, length, exponent, value);
+      return write_decimal(out, digits, length, exponent);
+   }
+}
+
+char* gb2gc::format_number(char* first, double value) noexcept
+{
+   return format_floating<double, std::uint64_t>(first, value);
+}
+
+char* gb2gc::format_number(char* first, float value) noexcept
+{
+   return format_floating<float, std::uint32_t>(first, value);
+}
+
+char* gb2gc::format_number(char* first, long double value) noexcept
+{
+   return format_number(first, static_cast<double>(value));
+}
+
+char* gb2gc::format_number(char* first, unsigned long long value) noexcept
+{
+   // Write digits backwards into a temporary buffer
+   char digits[20];
+   auto last = digits + sizeof(digits);
+   auto p = last;
+   do
+   {
+      *--p = static_cast<char>('0' + value % 10);
+      value /= 10;
+   } while (value != 0);
+   const auto n = static_cast<std::size_t>(last - p);
+   std::memcpy(first, p, n);
+   return first + n;
+}
+
+char* gb2gc::format_number(char* first, long long value) noexcept
+{
+   if (value >= 0)
+      return format_number(first, static_cast<unsigned long long>(value));
+   *first++ = '-';
+   // Negate in unsigned arithmetic to handle the minimum value
+   return format_number(first, 0ull - static_cast<unsigned long long>(value));
+}
@@ -0,0 +1,34 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_NUMBER_FORMAT_H
+#define GB2GC_NUMBER_FORMAT_H
+
+#include <cstddef>
+
+namespace gb2gc
+{
+   // Minimum size of a buffer passed to format_number
+   constexpr std::size_t max_number_chars = 32;
+
+   // Writes the given value to the buffer starting at first and returns a
+   // pointer past the last written character. No terminating null character
+   // is written. Floating point values are written with the shortest digits
+   // (Grisu2) that read back as the same value, formatted like JavaScript
+   // Number.prototype.toString, e.g. '1', '0.000032' or '1e-9'. Output never
+   // depends on the current locale. Long double values are written with
+   // double precision.
+   char* format_number(char* first, double value) noexcept;
+   char* format_number(char* first, float value) noexcept;
+   char* format_number(char* first, long double value) noexcept;
+   char* format_number(char* first, long long value) noexcept;
+   char* format_number(char* first, unsigned long long value) noexcept;
+
+} // namespace gb2gc
+
+#endif // GB2GC_NUMBER_FORMAT_H
@@ -3,12 +3,14 @@
 // root directory of this distribution.
 
 #include "gb2gc.h"
+#include "file_glob.h"
 
 struct option
 {
     using parser = std::function<int(const gb2gc::span<const char*>& args)>;
 
     char        flag;        // option flag
+    const char* name;        // long option name, or nullptr if none
     std::string description; // option description
     bool        required;    // is required option?
     unsigned    group;       // is option part of a group with id
@@ -56,7 +58,27 @@ std::string get_group_flags(unsigned group, const gb2gc::span<option>& options)
 
 bool is_option(const char* arg)
 {
-   return (arg[0] == '-' && arg[1] != '\0' && arg[2] == '\0');
+   return (arg[0] == '-' && arg[1] != '\0' &&
+      (arg[2] == '\0' || (arg[1] == '-' && arg[2] != '-')));
+}
+
+bool is_long_option(const char* arg)
+{
+   return arg[0] == '-' && arg[1] == '-';
+}
+
+bool matches(const option& opt, const char* arg)
+{
+   if (is_long_option(arg))
+      return opt.name != nullptr && strcmp(opt.name, &arg[2]) == 0;
+   return opt.flag != '\0' && opt.flag == arg[1];
+}
+
+std::string option_name(const option& opt)
+{
+   if (opt.flag == '\0')
+      return std::string("--") + opt.name;
+   return std::string("-") + opt.flag;
 }
 
 const std::vector<gb2gc::selector> gb2gc::options::default_selectors(
@@ -67,12 +89,23 @@ const std::vector<gb2gc::selector> gb2gc::options::default_selectors(
    });
 
 gb2gc::options::options()
+   : snapshot_(false)
+   , max_points_(0)
+   , dashboard_(false)
+   , svg_(false)
 { }
 
 const std::string&
 gb2gc::options::in_file() const
 {
-   return in_file_;
+   static const std::string none;
+   return in_files_.empty() ? none : in_files_[0];
+}
+
+const std::vector<std::string>&
+gb2gc::options::in_files() const
+{
+   return in_files_;
 }
 
 const std::string&
@@ -81,7 +114,37 @@ gb2gc::options::out_file() const
    return out_file_;
 }
 
+bool
+gb2gc::options::snapshot() const
+{
+   return snapshot_;
+}
+
+unsigned
+gb2gc::options::max_points() const
+{
+   return max_points_;
+}
+
+bool
+gb2gc::options::dashboard() const
+{
+   return dashboard_;
+}
+
+bool
+gb2gc::options::svg() const
+{
+   return svg_;
+}
+
 const std::string&
+gb2gc::options::manifest() const
+{
+   return manifest_;
+}
+
+const gb2gc::benchmark_filter&
 gb2gc::options::filter() const
 {
    return filter_;
@@ -176,15 +239,46 @@ gb2gc::options::parse_selector(const span<const char*>& args)
 {
    for (auto& arg : args)
    {
-      selectors_.emplace_back(selector(arg));
+      try
+      {
+         selectors_.emplace_back(selector(arg));
+      }
+      catch (const std::invalid_argument& e)
+      {
+         return show_error(e.what());
+      }
+   }
+   if (!selectors_.empty() && selectors_[0].is_aggregated())
+      return show_error("Key selector '" + selectors_[0].key() + "' cannot be aggregated");
+   return 0;
+}
+
+int
+gb2gc::options::parse_in_files(const span<const char*>& args)
+{
+   for (auto& arg : args)
+   {
+      if (strcmp(arg, "-") == 0 && std::count(in_files_.begin(), in_files_.end(), "-") != 0)
+         return show_error("Standard input ('-') may only be given once");
+      auto paths = expand_glob(arg);
+      if (paths.empty())
+         return show_error("No input files matching '" + std::string(arg) + "'");
+      in_files_.insert(in_files_.end(), paths.begin(), paths.end());
    }
    return 0;
 }
 
 int
-gb2gc::options::parse_filter(const char* arg)
+gb2gc::options::parse_filter(const span<const char*>& args)
 {
-   filter_ = arg;
+   try
+   {
+      filter_ = benchmark_filter(std::vector<std::string>(args.begin(), args.end()));
+   }
+   catch (std::invalid_argument& e)
+   {
+      return show_error(e.what());
+   }
    return 0;
 }
 
@@ -197,39 +291,57 @@ int gb2gc::options::parse(int argc, const char* argv[])
 
     option opts[] =
     {
-        option{ 'c', "Chart type.", 
+        option{ 'c', nullptr, "Chart type.", 
             true, 0, true, false, 1, [&](const span<const char*>& args)
             { return this->parse_chart_type(args[0]); } },
-        option{ 'f', "Filter benchmarks.",
+        option{ 'f', nullptr, "Filter benchmarks.",
             false, 0, true, false, 1, [&](const span<const char*>& args)
-            { return this->parse_filter(args[0]); } },
-        option{ 'h', "Chart height.",
+            { return this->parse_filter(args); } },
+        option{ 'h', nullptr, "Chart height.",
             false, 0, true, false, 1, [&](const span<const char*>& args)
             { return this->parse_size(gc_dom_options_.height, args[0]); } },
-        option{ 'i', "Input file.", 
+        option{ 'i', nullptr, "Input files.", 
             true, 0, true, false, 1, [&](const span<const char*>& args)
-            { in_file_ = args[0]; return 0; } },
-        option{ 'l', "Legend definition.", 
+            { return parse_in_files(args); } },
+        option{ 'l', nullptr, "Legend definition.", 
             false, 0, true, false, 1, [&](const span<const char*>& args)
             { return this->parse_legend(args[0]); } },
-        option{ 'o', "Output file.", 
+        option{ 'o', nullptr, "Output file.", 
             true, 0, true, false, 1, [&](const span<const char*>& args)
             { out_file_ = args[0]; return 0; } },
-        option{ 's', "Define data selectors (default is 'name', 'real_time', 'cpu_time')",
+        option{ 's', nullptr, "Define data selectors (default is 'name', 'real_time', 'cpu_time')",
             false, 0, true, false, 1, [&](const span<const char*>& args)
             { return parse_selector(args); } },
-        option{ 't', "Chart title.",
+        option{ 't', nullptr, "Chart title.",
             false, 0, true, false, 1, [&](const span<const char*>& args)
             { this->gc_options_.title = args[0]; return 0; } },
-        option{ 'w', "Chart width.",
+        option{ 'w', nullptr, "Chart width.",
             false, 0, true, false, 1, [&](const span<const char*>& args)
             { return this->parse_size(gc_dom_options_.width, args[0]); } },
-        option{ 'x', "X-axis title.", 
+        option{ 'x', nullptr, "X-axis title.", 
             false, 0, true, false, 1, [&](const span<const char*>& args)
             { this->gc_options_.horizontal_axis.title = args[0]; return 0; } },
-        option{ 'y', "Y-axis title.",
+        option{ 'y', nullptr, "Y-axis title.",
             false, 0, true, false, 1, [&](const span<const char*>& args)
-            { this->gc_options_.vertical_axis.title = args[0]; return 0; } }
+            { this->gc_options_.vertical_axis.title = args[0]; return 0; } },
+        option{ '\0', "snapshot", "Cache parsed input in a binary snapshot.",
+            false, 0, false, false, 1, [&](const span<const char*>&)
+            { snapshot_ = true; return 0; } },
+        option{ '\0', "compact", "Write compact output.",
+            false, 0, false, false, 1, [&](const span<const char*>&)
+            { gc_dom_options_.compact = true; return 0; } },
+        option{ '\0', "max-points", "Maximum number of points per series.",
+            false, 0, true, false, 1, [&](const span<const char*>& args)
+            { return this->parse_size(max_points_, args[0]); } },
+        option{ '\0', "dashboard", "Write one chart per series.",
+            false, 0, false, false, 1, [&](const span<const char*>&)
+            { dashboard_ = true; return 0; } },
+        option{ '\0', "svg", "Render a static SVG chart.",
+            false, 0, false, false, 1, [&](const span<const char*>&)
+            { svg_ = true; return 0; } },
+        option{ '\0', "manifest", "Generate all charts of a manifest.",
+            false, 0, true, false, 1, [&](const span<const char*>& args)
+            { manifest_ = args[0]; return 0; } }
     };
 
    auto options = make_span(&opts[0], sizeof(opts) / sizeof(option));
@@ -238,9 +350,8 @@ int gb2gc::options::parse(int argc, const char* argv[])
       auto arg = argv[i];
       if (!is_option(arg))
          return show_error("Expected option flag, found: " + std::string(arg));
-      if (arg[2] != '\0')
-         return show_error("Unrecognized option '" + std::string(arg) + "'");
-      auto it = std::find(options.begin(), options.end(), option{ arg[1] });
+      auto it = std::find_if(options.begin(), options.end(),
+         [&](const option& o) { return matches(o, arg); });
       if (it == options.end())
          return show_error("Unrecognized option '" + std::string(arg) + "'");
       if (!it->need_arg)
@@ -257,9 +368,7 @@ int gb2gc::options::parse(int argc, const char* argv[])
          ++last;
       if (last == first)
       {
-         std::string message("Missing argument for option -");
-         message += it->flag;
-         return show_error(message);
+         return show_error("Missing argument for option " + option_name(*it));
       }
 
       if (it->group != 0 && has_parsed_group_flag(it->group, options))
@@ -275,6 +384,14 @@ int gb2gc::options::parse(int argc, const char* argv[])
       i = last;
    }
 
+   // A manifest lists the options of each chart instead
+   if (!manifest_.empty())
+   {
+      if (argc != 3)
+         return show_error("Option --manifest may not be combined with other options");
+      return 0;
+   }
+
    for (auto& opt : opts)
    {
       if (opt.required && !opt.parsed)
@@ -287,12 +404,15 @@ int gb2gc::options::parse(int argc, const char* argv[])
             std::string message("One of the required options " + get_group_flags(opt.group, options) + " needs to be specified.");
             return show_error(message);
          }
-         std::string message("Missing required option -");
-         message += opt.flag;
-         return show_error(message);
+         return show_error("Missing required option " + option_name(opt));
       }
    }
 
+   // Downsampling keeps the shape of a series but would drop categories of a
+   // bar chart and distort the distribution of a histogram
+   if (max_points_ != 0 && gc_type_ != type::line && gc_type_ != type::scatter)
+      return show_error("Option --max-points only applies to line and scatter charts");
+
    return 0;
 }
 
@@ -305,28 +425,57 @@ void gb2gc::options::print_usage(const char* cmd)
    std::cout << "Usage:\n" << "  ";
    if (cmd)
       std::cout << cmd;
-   std::cout << "-c type[-f filter][-l legend]|-s[-h height]-i in_file[-n name...][-o out_file][-t title][-v][-w width]\n\n"
+   std::cout << "-c type[-f filter...][-l legend]|-s[-h height]-i in_file...[-n name...][-o out_file][-t title][-v][-w width][--snapshot][--compact][--max-points N][--dashboard][--svg]\n"
+      "  --manifest manifest_file\n\n"
       "Options:\n"
       "  -c               Chart type.\n"
       "  -f               Filter benchmarks.\n"
       "  -h               Chart height.\n"
-      "  -i               Input file.\n"
+      "  -i               Input files.\n"
       "  -l               Optional legend definition.\n"
       "  -n               Define benchmark parameter names.\n"
       "  -o               Optional output file.\n"
       "  -t               Optional chart title.\n"
       "  -s               Define data selectors (default is 'name', 'real_time', 'cpu_time')\n"
+      "                   Suffix a selector with ':aggregate' to aggregate repetitions.\n"
       "  -v               Optionally open and visualize chart directly after generation.\n"
       "  -w               Optional chart width.\n"
       "  -x               Optional x-axis title.\n"
       "  -y               Optional y-axis title.\n"
+      "  --snapshot       Optionally cache parsed input in a binary snapshot next to\n"
+      "                   the input file which is reused while the input is unchanged.\n"
+      "  --compact        Optionally write compact output without indentation, comments\n"
+      "                   or line breaks.\n"
+      "  --max-points     Optionally downsample each series to at most N points with\n"
+      "                   Largest-Triangle-Three-Buckets, keeping the shape of line\n"
+      "                   and scatter charts of very large series. Only applies to\n"
+      "                   line and scatter charts.\n"
+      "  --dashboard      Optionally write a single page with one chart per series\n"
+      "                   sharing a single embedded data table.\n"
+      "  --svg            Optionally render the chart as static SVG which displays\n"
+      "                   without JavaScript or network access.\n"
+      "  --manifest       Generate all charts listed in a JSON manifest file with\n"
+      "                   their inputs and options. Each distinct input is parsed\n"
+      "                   once and charts are rendered concurrently.\n"
       "\n"
       "Arguments:\n"
-      "  filter           Benchmark name to be matched. Wildcards ('*') can be used.\n"
+      "  aggregate        Statistic of repeated benchmarks with the same key. One of\n"
+      "                   'mean', 'median', 'min', 'max', 'stddev', 'cv' or 'p<N>'\n"
+      "                   for the N:th percentile, e.g. 'real_time:p90'.\n"
+      "  filter           Benchmark name pattern to be matched. Wildcards ('*', '?') can\n"
+      "                   be used within each '/' separated segment. Patterns prefixed\n"
+      "                   with 're:' are regular expressions like --benchmark_filter.\n"
+      "                   Patterns prefixed with '-' exclude matching benchmarks.\n"
       "  height           The height of the chart in pixels.\n"
-      "  in_file          The input benchmark JSON file path.\n"
-      "  legend           Legend position, one of 'none', 'left', 'top', 'right', 'bottom'. Defaults to 'none'"
+      "  in_file          The input benchmark JSON file path. Wildcards ('*', '?') can\n"
+      "                   be used and multiple files are merged into a single chart.\n"
+      "                   Use '-' to read from standard input, e.g. piped benchmark output.\n"
+      "  legend           Legend position, one of 'none', 'left', 'top', 'right', 'bottom'. Defaults to 'none'.\n"
+      "  manifest_file    JSON file of the form { \"charts\": [ { \"input\": [...],\n"
+      "                   \"output\": ..., \"type\": ..., ... } ] } where chart keys\n"
+      "                   correspond to the options above, see the README.\n"
       "  out_file         The output file path. Defaults to working directory.\n"
+      "                   Use '-' to write to standard output.\n"
       "  title            The title of the chart.\n"
       "  type             The chart type. One of 'bar', 'line', 'scatter'.\n"
       "  width            The width of the chart in pixels.\n"
@@ -0,0 +1,281 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "output_sink.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "number_format.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GB2GC_HAS_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#else
+#define GB2GC_HAS_POSIX_IO 0
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+   // Spaces appended in chunks for indentation
+   const char spaces[] =
+      "                                                                "
+      "                                                                ";
+   constexpr std::size_t spaces_size = sizeof(spaces) - 1;
+
+   void throw_write_error()
+   {
+      throw std::runtime_error(std::string("Failed to write output: ") + std::strerror(errno));
+   }
+
+   // Writes all given bytes, retrying partial and interrupted writes
+   void write_fd(int fd, const char* data, std::size_t size)
+   {
+      while (size != 0)
+      {
+#if GB2GC_HAS_POSIX_IO
+         const auto written = ::write(fd, data, size);
+#else
+         const auto chunk = static_cast<unsigned>(size > (1u << 30) ? (1u << 30) : size);
+         const auto written = ::_write(fd, data, chunk);
+#endif
+         if (written < 0)
+         {
+            if (errno == EINTR)
+               continue;
+            throw_write_error();
+         }
+         data += written;
+         size -= static_cast<std::size_t>(written);
+      }
+   }
+}
+
+gb2gc::output_sink::output_sink()
+   : os_(nullptr), fd_(-1), owned_(false)
+{ }
+
+gb2gc::output_sink::output_sink(std::ostream& os)
+   : os_(&os), fd_(-1), owned_(false)
+{
+   buffer_.reserve(default_capacity);
+}
+
+gb2gc::output_sink::output_sink(int fd, bool owned)
+   : os_(nullptr), fd_(fd), owned_(owned)
+{
+   buffer_.reserve(default_capacity);
+}
+
+gb2gc::output_sink::~output_sink() noexcept
+{
+   try
+   {
+      flush();
+   }
+   catch (...)
+   { }
+   close();
+}
+
+gb2gc::output_sink::output_sink(output_sink&& other) noexcept
+   : buffer_(std::move(other.buffer_)), os_(other.os_), fd_(other.fd_), owned_(other.owned_)
+{
+   other.buffer_.clear();
+   other.os_ = nullptr;
+   other.fd_ = -1;
+   other.owned_ = false;
+}
+
+gb2gc::output_sink&
+gb2gc::output_sink::operator=(output_sink&& other) noexcept
+{
+   if (this != &other)
+   {
+      try
+      {
+         flush();
+      }
+      catch (...)
+      { }
+      close();
+      buffer_ = std::move(other.buffer_);
+      os_ = other.os_;
+      fd_ = other.fd_;
+      owned_ = other.owned_;
+      other.buffer_.clear();
+      other.os_ = nullptr;
+      other.fd_ = -1;
+      other.owned_ = false;
+   }
+   return *this;
+}
+
+gb2gc::output_sink gb2gc::output_sink::open(const std::string& path)
+{
+   if (path == "-")
+   {
+#if GB2GC_HAS_POSIX_IO
+      return output_sink(STDOUT_FILENO);
+#else
+      return output_sink(1);
+#endif
+   }
+
+#if GB2GC_HAS_POSIX_IO
+   const auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+#else
+   const auto fd = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC, _S_IREAD | _S_IWRITE);
+#endif
+   if (fd < 0)
+      throw std::runtime_error("Failed to open output file '" + path + "'");
+   return output_sink(fd, true);
+}
+
+void gb2gc::output_sink::append(const char* data, std::size_t size)
+{
+   if (!target() || buffer_.size() + size <= buffer_.capacity())
+   {
+      buffer_.insert(buffer_.end(), data, data + size);
+      return;
+   }
+
+   // Large blocks are written together with pending output without being
+   // copied into the buffer
+   if (size >= default_capacity / 2)
+   {
+      write(buffer_.data(), buffer_.size(), data, size);
+      buffer_.clear();
+      return;
+   }
+
+   flush_buffer();
+   buffer_.insert(buffer_.end(), data, data + size);
+}
+
+void gb2gc::output_sink::indent(std::size_t count)
+{
+   while (count > spaces_size)
+   {
+      append(spaces, spaces_size);
+      count -= spaces_size;
+   }
+   append(spaces, count);
+}
+
+void gb2gc::output_sink::flush()
+{
+   if (!target())
+      return;
+   flush_buffer();
+   if (os_)
+      os_->flush();
+}
+
+void gb2gc::output_sink::flush_buffer()
+{
+   write(buffer_.data(), buffer_.size());
+   buffer_.clear();
+}
+
+void gb2gc::output_sink::write(const char* data, std::size_t size)
+{
+   if (size == 0)
+      return;
+   if (os_)
+   {
+      if (!os_->write(data, static_cast<std::streamsize>(size)))
+         throw std::runtime_error("Failed to write output");
+   }
+   else
+   {
+      write_fd(fd_, data, size);
+   }
+}
+
+void gb2gc::output_sink::write(const char* first, std::size_t first_size,
+   const char* second, std::size_t second_size)
+{
+#if GB2GC_HAS_POSIX_IO
+   if (fd_ >= 0 && first_size != 0)
+   {
+      iovec iov[2] = { 
+         { const_cast<char*>(first), first_size },
+         { const_cast<char*>(second), second_size } 
+      };
+      ssize_t written;
+      do
+      {
+         written = ::writev(fd_, iov, 2);
+      } while (written < 0 && errno == EINTR);
+      if (written < 0)
+         throw_write_error();
+
+      // Complete partial writes
+      auto n = static_cast<std::size_t>(written);
+      if (n < first_size)
+      {
+         write_fd(fd_, first + n, first_size - n);
+         n = 0;
+      }
+      else
+      {
+         n -= first_size;
+      }
+      write_fd(fd_, second + n, second_size - n);
+      return;
+   }
+#endif
+   write(first, first_size);
+   write(second, second_size);
+}
+
+void gb2gc::output_sink::close() noexcept
+{
+   if (owned_ && fd_ >= 0)
+   {
+#if GB2GC_HAS_POSIX_IO
+      ::close(fd_);
+#else
+      ::_close(fd_);
+#endif
+   }
+   fd_ = -1;
+   owned_ = false;
+}
+
+gb2gc::output_sink& gb2gc::operator<<(output_sink& sink, long long value)
+{
+   char buffer[max_number_chars];
+   sink.append(buffer, static_cast<std::size_t>(format_number(buffer, value) - buffer));
+   return sink;
+}
+
+gb2gc::output_sink& gb2gc::operator<<(output_sink& sink, unsigned long long value)
+{
+   char buffer[max_number_chars];
+   sink.append(buffer, static_cast<std::size_t>(format_number(buffer, value) - buffer));
+   return sink;
+}
+
+gb2gc::output_sink& gb2gc::operator<<(output_sink& sink, float value)
+{
+   char buffer[max_number_chars];
+   sink.append(buffer, static_cast<std::size_t>(format_number(buffer, value) - buffer));
+   return sink;
+}
+
+gb2gc::output_sink& gb2gc::operator<<(output_sink& sink, double value)
+{
+   char buffer[max_number_chars];
+   sink.append(buffer, static_cast<std::size_t>(format_number(buffer, value) - buffer));
+   return sink;
+}
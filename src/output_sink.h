@@ -0,0 +1,132 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_OUTPUT_SINK_H
+#define GB2GC_OUTPUT_SINK_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gb2gc
+{
+   // Buffered output of generated documents. Output is appended to a growable
+   // byte buffer which is written to the destination in large blocks when
+   // full and when flushed. The destination is either a file descriptor, a
+   // stream or, if none, the buffer itself which then holds all output.
+   class output_sink final
+   {
+   public:
+      // Buffered bytes written to the destination at once
+      static constexpr std::size_t default_capacity = 256 * 1024;
+
+      // Constructs a sink collecting all output in memory
+      output_sink();
+
+      // Constructs a sink writing to the given stream
+      explicit output_sink(std::ostream& os);
+
+      // Constructs a sink writing to the given file descriptor which is
+      // closed on destruction if owned
+      explicit output_sink(int fd, bool owned = false);
+
+      // Flushes pending output, errors are ignored, use flush() to detect them
+      ~output_sink() noexcept;
+
+      output_sink(const output_sink&) = delete;
+      output_sink& operator=(const output_sink&) = delete;
+      output_sink(output_sink&& other) noexcept;
+      output_sink& operator=(output_sink&& other) noexcept;
+
+      // Returns a sink writing to the given file, or to standard output if
+      // the path is '-'. Throws std::runtime_error if the file cannot be
+      // opened.
+      static output_sink open(const std::string& path);
+
+      void append(const char* data, std::size_t size);
+      void append(const std::string& s) { append(s.data(), s.size()); }
+      void append(char c)
+      {
+         if (buffer_.size() == buffer_.capacity() && target())
+            flush_buffer();
+         buffer_.push_back(c);
+      }
+
+      // Appends the given number of spaces
+      void indent(std::size_t count);
+
+      // Writes all pending output to the destination. Throws
+      // std::runtime_error if writing fails.
+      void flush();
+
+      // Returns output not yet written to the destination, i.e. all output
+      // of a sink collecting output in memory
+      std::string str() const { return std::string(buffer_.data(), buffer_.size()); }
+
+   private:
+      bool target() const noexcept { return os_ != nullptr || fd_ >= 0; }
+      void flush_buffer();
+      void write(const char* data, std::size_t size);
+      void write(const char* first, std::size_t first_size,
+         const char* second, std::size_t second_size);
+      void close() noexcept;
+
+      std::vector<char> buffer_;
+      std::ostream*     os_;
+      int               fd_;
+      bool              owned_;
+   };
+
+   inline output_sink& operator<<(output_sink& sink, const char* s)
+   {
+      sink.append(s, std::char_traits<char>::length(s));
+      return sink;
+   }
+
+   inline output_sink& operator<<(output_sink& sink, const std::string& s)
+   {
+      sink.append(s);
+      return sink;
+   }
+
+   inline output_sink& operator<<(output_sink& sink, char c)
+   {
+      sink.append(c);
+      return sink;
+   }
+
+   // Numbers are written like format_number
+   output_sink& operator<<(output_sink& sink, long long value);
+   output_sink& operator<<(output_sink& sink, unsigned long long value);
+   output_sink& operator<<(output_sink& sink, float value);
+   output_sink& operator<<(output_sink& sink, double value);
+
+   inline output_sink& operator<<(output_sink& sink, int value)
+   {
+      return sink << static_cast<long long>(value);
+   }
+
+   inline output_sink& operator<<(output_sink& sink, unsigned value)
+   {
+      return sink << static_cast<unsigned long long>(value);
+   }
+
+   inline output_sink& operator<<(output_sink& sink, long value)
+   {
+      return sink << static_cast<long long>(value);
+   }
+
+   inline output_sink& operator<<(output_sink& sink, unsigned long value)
+   {
+      return sink << static_cast<unsigned long long>(value);
+   }
+
+} // namespace gb2gc
+
+#endif // GB2GC_OUTPUT_SINK_H
@@ -0,0 +1,216 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// escape_streambuf
+
+constexpr size_t gb2gc::escape_streambuf::buffer_size;
+
+gb2gc::escape_streambuf::escape_streambuf(std::streambuf* source)
+   : source_(source), buffer_(buffer_size)
+{ }
+
+gb2gc::escape_streambuf::int_type
+gb2gc::escape_streambuf::underflow()
+{
+   if (gptr() < egptr())
+      return traits_type::to_int_type(*gptr());
+
+   // Block until input is available and then only consume what the source
+   // already has buffered. This avoids waiting for a full buffer when reading
+   // from a pipe so that benchmarks are parsed as soon as they are written.
+   if (traits_type::eq_int_type(source_->sgetc(), traits_type::eof()))
+      return traits_type::eof();
+   auto count = static_cast<std::streamsize>(buffer_.size());
+   const auto available = source_->in_avail();
+   if (available > 0 && available < count)
+      count = available;
+   const auto n = source_->sgetn(buffer_.data(), count);
+   if (n <= 0)
+      return traits_type::eof();
+
+   const auto first = buffer_.data();
+   const auto last = first + n;
+   std::replace(first, last, '\\', '/');
+   setg(first, first, last);
+   return traits_type::to_int_type(*gptr());
+}
+
+// escaped_view_streambuf
+
+gb2gc::escaped_view_streambuf::escaped_view_streambuf(const char* data, std::size_t size)
+   : pos_(data), end_(data + size), substitute_('/')
+{ }
+
+gb2gc::escaped_view_streambuf::int_type
+gb2gc::escaped_view_streambuf::underflow()
+{
+   if (gptr() < egptr())
+      return traits_type::to_int_type(*gptr());
+   if (pos_ == end_)
+      return traits_type::eof();
+
+   if (*pos_ == '\\')
+   {
+      ++pos_;
+      setg(&substitute_, &substitute_, &substitute_ + 1);
+   }
+   else
+   {
+      // Get area is never written to, hence safe to expose read-only memory
+      auto next = static_cast<const char*>(
+         std::memchr(pos_, '\\', static_cast<std::size_t>(end_ - pos_)));
+      if (!next)
+         next = end_;
+      const auto first = const_cast<char*>(pos_);
+      setg(first, first, const_cast<char*>(next));
+      pos_ = next;
+   }
+   return traits_type::to_int_type(*gptr());
+}
+
+// benchmark_input
+
+bool gb2gc::is_standard_input(const std::string& path)
+{
+   return path == "-";
+}
+
+gb2gc::benchmark_input::benchmark_input(const std::string& path)
+{
+   if (is_standard_input(path))
+   {
+      buf_.reset(new escape_streambuf(std::cin.rdbuf()));
+      return;
+   }
+
+   if (map_.open(path))
+   {
+      buf_.reset(new escaped_view_streambuf(map_.data(), map_.size()));
+      return;
+   }
+
+   file_.reset(new std::filebuf());
+   if (!file_->open(path, std::ios::in | std::ios::binary))
+      throw std::runtime_error("File non-existent or failed to open file: " + path);
+   buf_.reset(new escape_streambuf(file_.get()));
+}
+
+std::streambuf* gb2gc::benchmark_input::rdbuf() noexcept
+{
+   return buf_.get();
+}
+
+bool gb2gc::benchmark_input::is_mapped() const noexcept
+{
+   return map_.is_open();
+}
+
+// benchmark_reader
+
+constexpr std::size_t gb2gc::benchmark_reader::field_depth;
+
+gb2gc::benchmark_reader::benchmark_reader(
+   std::vector<std::string> fields, callback on_benchmark)
+   : fields_(std::move(fields)), on_benchmark_(std::move(on_benchmark)),
+   depth_(0), keep_(false), benchmarks_key_(false), in_benchmarks_(false)
+{ }
+
+bool gb2gc::benchmark_reader::is_field() const noexcept
+{
+   return in_benchmarks_ && depth_ == field_depth;
+}
+
+bool gb2gc::benchmark_reader::null()
+{
+   return value(nullptr);
+}
+
+bool gb2gc::benchmark_reader::boolean(bool val)
+{
+   return value(val);
+}
+
+bool gb2gc::benchmark_reader::number_integer(json::number_integer_t val)
+{
+   return value(val);
+}
+
+bool gb2gc::benchmark_reader::number_unsigned(json::number_unsigned_t val)
+{
+   return value(val);
+}
+
+bool gb2gc::benchmark_reader::number_float(json::number_float_t val, const json::string_t&)
+{
+   return value(val);
+}
+
+bool gb2gc::benchmark_reader::string(json::string_t& val)
+{
+   return value(std::move(val));
+}
+
+bool gb2gc::benchmark_reader::start_object(std::size_t)
+{
+   // Values nested within a benchmark field are never retained
+   if (is_field())
+      keep_ = false;
+   ++depth_;
+   if (in_benchmarks_ && depth_ == field_depth)
+      benchmark_ = json::object();
+   return true;
+}
+
+bool gb2gc::benchmark_reader::key(json::string_t& val)
+{
+   if (depth_ == 1)
+   {
+      benchmarks_key_ = (val == "benchmarks");
+   }
+   else if (is_field())
+   {
+      keep_ = fields_.empty() ||
+         std::find(fields_.begin(), fields_.end(), val) != fields_.end();
+      if (keep_)
+         key_ = std::move(val);
+   }
+   return true;
+}
+
+bool gb2gc::benchmark_reader::end_object()
+{
+   if (is_field())
+   {
+      keep_ = false;
+      on_benchmark_(std::move(benchmark_));
+      benchmark_ = json();
+   }
+   --depth_;
+   return true;
+}
+
+bool gb2gc::benchmark_reader::start_array(std::size_t)
+{
+   // Values nested within a benchmark field are never retained
+   if (is_field())
+      keep_ = false;
+   ++depth_;
+   if (depth_ == 2 && benchmarks_key_)
+      in_benchmarks_ = true;
+   return true;
+}
+
+bool gb2gc::benchmark_reader::end_array()
+{
+   if (depth_ == 2)
+      in_benchmarks_ = false;
+   --depth_;
+   return true;
+}
@@ -0,0 +1,145 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_READER_H
+#define GB2GC_READER_H
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "mapped_file.h"
+
+namespace gb2gc
+{
+   // Stream buffer filter replacing backslashes while reading from an
+   // underlying stream buffer. Google Benchmark do not escape backslashes
+   // in benchmark names which otherwise results in invalid JSON.
+   class escape_streambuf final : public std::streambuf
+   {
+   public:
+      static constexpr size_t buffer_size = 64 * 1024;
+
+      explicit escape_streambuf(std::streambuf* source);
+
+   protected:
+      int_type underflow() override;
+
+   private:
+      std::streambuf*   source_;
+      std::vector<char> buffer_;
+   };
+
+   // Read-only stream buffer viewing a contiguous memory region in place.
+   // Backslashes are replaced lazily by handing out a substitute character
+   // in place of each backslash instead of copying the underlying memory.
+   class escaped_view_streambuf final : public std::streambuf
+   {
+   public:
+      escaped_view_streambuf(const char* data, std::size_t size);
+
+   protected:
+      int_type underflow() override;
+
+   private:
+      const char* pos_;
+      const char* end_;
+      char        substitute_;
+   };
+
+   // Returns true if the given input path denotes standard input, i.e. '-'
+   bool is_standard_input(const std::string& path);
+
+   // Benchmark JSON input with escaping applied. Regular files are memory
+   // mapped and parsed in place where supported while other inputs, e.g.
+   // pipes, fall back to buffered reads.
+   class benchmark_input final
+   {
+   public:
+      // Opens the given file or standard input if the path is '-'. Throws
+      // std::runtime_error if the file cannot be opened.
+      explicit benchmark_input(const std::string& path);
+
+      std::streambuf* rdbuf() noexcept;
+      bool is_mapped() const noexcept;
+
+   private:
+      mapped_file                     map_;
+      std::unique_ptr<std::filebuf>   file_;
+      std::unique_ptr<std::streambuf> buf_;
+   };
+
+   // SAX handler reading Google Benchmark JSON output. Only the 'benchmarks'
+   // array is retained and only the scalar benchmark fields listed in the
+   // given field set, or all scalar fields if the field set is empty. Each
+   // benchmark is handed over to the given callback as soon as it has been
+   // completely parsed.
+   class benchmark_reader final
+   {
+   public:
+      using json = nlohmann::json;
+      using callback = std::function<void(json&& benchmark)>;
+
+      benchmark_reader(std::vector<std::string> fields, callback on_benchmark);
+
+      bool null();
+      bool boolean(bool value);
+      bool number_integer(json::number_integer_t value);
+      bool number_unsigned(json::number_unsigned_t value);
+      bool number_float(json::number_float_t value, const json::string_t& s);
+      bool string(json::string_t& value);
+      bool start_object(std::size_t elements);
+      bool key(json::string_t& value);
+      bool end_object();
+      bool start_array(std::size_t elements);
+      bool end_array();
+
+      // Binary values cannot occur in JSON text input. Declared as a template
+      // to be compatible with both old and new versions of the SAX interface.
+      template<class Binary>
+      bool binary(Binary&) { return true; }
+
+      template<class Exception>
+      bool parse_error(std::size_t, const std::string&, const Exception& ex)
+      {
+         throw std::runtime_error(ex.what());
+      }
+
+   private:
+      // Depth of a benchmark object field value in Google Benchmark output
+      static constexpr std::size_t field_depth = 3;
+
+      bool is_field() const noexcept;
+
+      template<class T>
+      bool value(T&& value)
+      {
+         if (keep_ && is_field())
+            benchmark_[key_] = std::forward<T>(value);
+         return true;
+      }
+
+      std::vector<std::string> fields_;
+      callback                 on_benchmark_;
+      json                     benchmark_;
+      std::string              key_;
+      std::size_t              depth_;
+      bool                     keep_;
+      bool                     benchmarks_key_;
+      bool                     in_benchmarks_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_READER_H
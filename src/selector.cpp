@@ -12,7 +12,14 @@ namespace {
 gb2gc::selector::selector(const std::string& name) :
    key_(name), param_index_(param_none)
 {
-   auto splits = split(name, '/');
+   const auto colon = name.rfind(':');
+   if (colon != std::string::npos)
+   {
+      aggregate_ = gb2gc::aggregate(name.substr(colon + 1));
+      key_ = name.substr(0, colon);
+   }
+
+   auto splits = split(key_, '/');
    if (splits.size() == 2)
    {
       key_ = splits[0];
@@ -69,16 +76,30 @@ gb2gc::selector::param_index() const
    return param_index_;
 }
 
+bool
+gb2gc::selector::is_aggregated() const
+{
+   return aggregate_.kind() != gb2gc::aggregate::function::first;
+}
+
+const gb2gc::aggregate&
+gb2gc::selector::aggregation() const
+{
+   return aggregate_;
+}
+
 std::vector<std::string>
 gb2gc::split(const std::string& s, char delimiter)
 {
    std::vector<std::string> tokens;
-   if (!s.empty())
+   auto first = std::string::size_type(0);
+   while (first < s.size())
    {
-      std::string token;
-      std::istringstream tokenStream(s);
-      while (std::getline(tokenStream, token, delimiter))
-         tokens.push_back(token);
+      auto last = s.find(delimiter, first);
+      if (last == std::string::npos)
+         last = s.size();
+      tokens.emplace_back(s, first, last - first);
+      first = last + 1;
    }
    return tokens;
 }
@@ -0,0 +1,602 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "snapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char snapshot_magic[8] = { 'G', 'B', '2', 'G', 'C', 'S', 'N', 'P' };
+constexpr std::uint32_t snapshot_version = 1;
+
+// All multi-byte values are stored in native byte order since a snapshot is
+// a local cache that is never distributed.
+struct header
+{
+   char          magic[8];
+   std::uint32_t version;
+   std::uint32_t columns;
+   std::uint64_t rows;
+   std::uint64_t input_size;
+   std::int64_t  input_mtime;
+   std::uint64_t input_hash;
+   std::uint64_t strings_offset;
+   std::uint64_t columns_offset;
+};
+
+struct column_entry
+{
+   std::uint32_t name;
+   std::uint32_t kind;
+   std::uint64_t presence_offset;
+   std::uint64_t values_offset;
+};
+
+using column_kind = gb2gc::snapshot::column_kind;
+
+std::size_t value_size(column_kind kind) noexcept
+{
+   switch (kind)
+   {
+   case column_kind::boolean: return sizeof(std::uint8_t);
+   case column_kind::integer: return sizeof(std::int64_t);
+   case column_kind::real:    return sizeof(double);
+   case column_kind::string:  return sizeof(std::uint32_t);
+   default:                   return 0;
+   }
+}
+
+template<class T>
+T load(const char* p) noexcept
+{
+   T value;
+   std::memcpy(&value, p, sizeof(T));
+   return value;
+}
+
+template<class T>
+void append(std::vector<char>& buffer, const T& value)
+{
+   const auto p = reinterpret_cast<const char*>(&value);
+   buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+template<class T>
+void store(std::vector<char>& buffer, std::size_t offset, const T& value) noexcept
+{
+   std::memcpy(&buffer[offset], &value, sizeof(T));
+}
+
+void align(std::vector<char>& buffer)
+{
+   buffer.resize((buffer.size() + 7u) & ~static_cast<std::size_t>(7u));
+}
+
+std::uint64_t rotl(std::uint64_t x, int r) noexcept
+{
+   return (x << r) | (x >> (64 - r));
+}
+
+std::uint64_t mix(std::uint64_t h) noexcept
+{  // Final avalanche of MurmurHash3
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33;
+   return h;
+}
+
+bool kind_of(const nlohmann::json& value, column_kind& kind)
+{
+   if (value.is_boolean())
+      kind = column_kind::boolean;
+   else if (value.is_number_float())
+      kind = column_kind::real;
+   else if (value.is_number_unsigned())
+      kind = value.get<std::uint64_t>() <= static_cast<std::uint64_t>(
+         (std::numeric_limits<std::int64_t>::max)()) ? column_kind::integer : column_kind::real;
+   else if (value.is_number_integer())
+      kind = column_kind::integer;
+   else if (value.is_string())
+      kind = column_kind::string;
+   else
+      return false;
+   return true;
+}
+
+// Returns a temporary path next to the given path which is unique to this
+// process and invocation, such that concurrent writers never share it
+std::string temp_path(const std::string& path)
+{
+   static std::atomic<unsigned> counter(0);
+#ifdef _WIN32
+   const auto pid = static_cast<unsigned long>(::GetCurrentProcessId());
+#else
+   const auto pid = static_cast<unsigned long>(::getpid());
+#endif
+   return path + "." + std::to_string(pid) + "." + std::to_string(counter++) + ".tmp";
+}
+
+// Atomically replaces the file at path 'to' with the file at path 'from'.
+// Readers either see the previous or the new file, never a missing file.
+bool replace_file(const std::string& from, const std::string& to)
+{
+#ifdef _WIN32
+   return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+   return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+} // namespace
+
+// input_signature
+
+bool gb2gc::input_signature::read(const std::string& path)
+{
+   struct stat st;
+   if (::stat(path.c_str(), &st) != 0 || (st.st_mode & S_IFMT) != S_IFREG)
+      return false;
+
+   std::ifstream in;
+   mapped_file map;
+   std::vector<char> buffer;
+   const char* data = nullptr;
+   std::size_t n = 0;
+   if (map.open(path))
+   {
+      data = map.data();
+      n = map.size();
+   }
+   else
+   {
+      in.open(path, std::ios::in | std::ios::binary);
+      if (!in)
+         return false;
+      buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      data = buffer.data();
+      n = buffer.size();
+   }
+
+   size = static_cast<std::uint64_t>(st.st_size);
+   mtime = static_cast<std::int64_t>(st.st_mtime);
+   hash = hash_bytes(data, n);
+   return true;
+}
+
+bool gb2gc::input_signature::operator==(const input_signature& other) const noexcept
+{
+   return size == other.size && mtime == other.mtime && hash == other.hash;
+}
+
+bool gb2gc::input_signature::operator!=(const input_signature& other) const noexcept
+{
+   return !(*this == other);
+}
+
+std::uint64_t gb2gc::hash_bytes(const char* data, std::size_t size) noexcept
+{
+   // Four independent lanes consuming 32 bytes per iteration keeps hashing
+   // cheap compared to parsing even for very large inputs.
+   const std::uint64_t k = 0x9e3779b97f4a7c15ULL;
+   std::uint64_t h[4] = { k, k ^ 1u, k ^ 2u, k ^ 3u };
+   const auto n = size;
+   while (size >= 32)
+   {
+      for (auto i = 0u; i < 4u; ++i)
+         h[i] = rotl(h[i] ^ load<std::uint64_t>(data + i * 8u), 31) * k;
+      data += 32;
+      size -= 32;
+   }
+   auto result = static_cast<std::uint64_t>(n) * k;
+   for (auto i = 0u; i < 4u; ++i)
+      result = rotl(result ^ mix(h[i]), 27) * k;
+   while (size > 0)
+   {
+      result = (result ^ static_cast<unsigned char>(*data++)) * 0x100000001b3ULL;
+      --size;
+   }
+   return mix(result);
+}
+
+// snapshot
+
+std::string gb2gc::snapshot::path_for(const std::string& input_path)
+{
+   return input_path + ".gb2gc";
+}
+
+bool gb2gc::snapshot::write(const std::string& path,
+   const input_signature& signature, const nlohmann::json& benchmarks)
+{
+   if (!benchmarks.is_array())
+      return false;
+
+   // Determine columns and their kinds in order of first occurrence
+   struct column_info
+   {
+      std::string name;
+      column_kind kind;
+   };
+   std::vector<column_info> columns;
+   std::unordered_map<std::string, std::size_t> column_index;
+   for (const auto& bm : benchmarks)
+   {
+      for (auto it = bm.begin(); it != bm.end(); ++it)
+      {
+         column_kind kind;
+         if (!kind_of(it.value(), kind))
+            continue; // null or nested values are not retained by the reader
+         auto found = column_index.find(it.key());
+         if (found == column_index.end())
+         {
+            column_index.emplace(it.key(), columns.size());
+            columns.push_back(column_info{ it.key(), kind });
+            continue;
+         }
+         auto& existing = columns[found->second].kind;
+         if (existing == kind)
+            continue;
+         if ((existing == column_kind::integer && kind == column_kind::real) ||
+             (existing == column_kind::real && kind == column_kind::integer))
+            existing = column_kind::real;
+         else
+            return false; // mixed kinds cannot be represented
+      }
+   }
+
+   // String table with deduplicated strings, column names included
+   std::vector<std::string> strings;
+   std::unordered_map<std::string, std::uint32_t> string_index;
+   auto intern = [&](const std::string& s)
+   {
+      auto found = string_index.find(s);
+      if (found != string_index.end())
+         return found->second;
+      const auto index = static_cast<std::uint32_t>(strings.size());
+      string_index.emplace(s, index);
+      strings.push_back(s);
+      return index;
+   };
+   std::vector<std::uint32_t> column_names;
+   for (const auto& c : columns)
+      column_names.push_back(intern(c.name));
+   for (const auto& bm : benchmarks)
+   {
+      for (auto it = bm.begin(); it != bm.end(); ++it)
+      {
+         if (it.value().is_string())
+            intern(it.value().get_ref<const std::string&>());
+      }
+   }
+
+   const auto rows = benchmarks.size();
+   std::vector<char> buffer(sizeof(header));
+   align(buffer);
+
+   // String table: count, offsets[count + 1], characters
+   const auto strings_offset = buffer.size();
+   append(buffer, static_cast<std::uint32_t>(strings.size()));
+   append(buffer, static_cast<std::uint32_t>(0));
+   std::uint32_t offset = 0;
+   for (const auto& s : strings)
+   {
+      append(buffer, offset);
+      offset += static_cast<std::uint32_t>(s.size());
+   }
+   append(buffer, offset);
+   for (const auto& s : strings)
+      buffer.insert(buffer.end(), s.begin(), s.end());
+   align(buffer);
+
+   // Column directory followed by presence bitmap and values per column
+   const auto columns_offset = buffer.size();
+   buffer.resize(buffer.size() + columns.size() * sizeof(column_entry));
+   for (auto ci = 0u; ci < columns.size(); ++ci)
+   {
+      const auto& c = columns[ci];
+      column_entry entry;
+      entry.name = column_names[ci];
+      entry.kind = static_cast<std::uint32_t>(c.kind);
+
+      align(buffer);
+      entry.presence_offset = buffer.size();
+      buffer.resize(buffer.size() + (rows + 7u) / 8u);
+      align(buffer);
+      entry.values_offset = buffer.size();
+      buffer.resize(buffer.size() + rows * value_size(c.kind));
+
+      auto row = 0u;
+      for (const auto& bm : benchmarks)
+      {
+         const auto value = bm.find(c.name);
+         if (value != bm.end() && !value->is_null())
+         {
+            buffer[entry.presence_offset + row / 8u] |= static_cast<char>(1u << (row % 8u));
+            const auto at = entry.values_offset + row * value_size(c.kind);
+            switch (c.kind)
+            {
+            case column_kind::boolean:
+               store(buffer, at, static_cast<std::uint8_t>(value->get<bool>() ? 1u : 0u));
+               break;
+            case column_kind::integer:
+               store(buffer, at, value->get<std::int64_t>());
+               break;
+            case column_kind::real:
+               store(buffer, at, value->get<double>());
+               break;
+            case column_kind::string:
+               store(buffer, at, string_index[value->get_ref<const std::string&>()]);
+               break;
+            }
+         }
+         ++row;
+      }
+      store(buffer, columns_offset + ci * sizeof(column_entry), entry);
+   }
+
+   header h;
+   std::memcpy(h.magic, snapshot_magic, sizeof(h.magic));
+   h.version = snapshot_version;
+   h.columns = static_cast<std::uint32_t>(columns.size());
+   h.rows = rows;
+   h.input_size = signature.size;
+   h.input_mtime = signature.mtime;
+   h.input_hash = signature.hash;
+   h.strings_offset = strings_offset;
+   h.columns_offset = columns_offset;
+   store(buffer, 0, h);
+
+   // Write to a temporary file and rename it over the snapshot to avoid
+   // exposing a partially written snapshot to concurrent readers. Concurrent
+   // writers use distinct temporary files and the last rename wins.
+   const auto temp = temp_path(path);
+   {
+      std::ofstream out(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!out)
+         return false;
+      out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      if (!out)
+      {
+         out.close();
+         std::remove(temp.c_str());
+         return false;
+      }
+   }
+   if (!replace_file(temp, path))
+   {
+      std::remove(temp.c_str());
+      return false;
+   }
+   return true;
+}
+
+bool gb2gc::snapshot::open(const std::string& path, const input_signature& signature)
+{
+   map_.close();
+   buffer_.clear();
+   columns_.clear();
+
+   const char* data;
+   std::size_t size;
+   if (map_.open(path))
+   {
+      data = map_.data();
+      size = map_.size();
+   }
+   else
+   {
+      std::ifstream in(path, std::ios::in | std::ios::binary);
+      if (!in)
+         return false;
+      buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      data = buffer_.data();
+      size = buffer_.size();
+   }
+
+   if (size < sizeof(header))
+      return false;
+   const auto h = load<header>(data);
+   if (std::memcmp(h.magic, snapshot_magic, sizeof(h.magic)) != 0 ||
+       h.version != snapshot_version ||
+       h.input_size != signature.size ||
+       h.input_mtime != signature.mtime ||
+       h.input_hash != signature.hash ||
+       h.rows > size)
+      return false;
+
+   // Validate string table
+   if (h.strings_offset > size || size - h.strings_offset < 8u)
+      return false;
+   const auto count = load<std::uint32_t>(data + h.strings_offset);
+   const auto offsets_size = (static_cast<std::uint64_t>(count) + 1u) * sizeof(std::uint32_t);
+   if (size - h.strings_offset - 8u < offsets_size)
+      return false;
+   const auto chars_offset = h.strings_offset + 8u + offsets_size;
+   const auto chars_size = load<std::uint32_t>(data + h.strings_offset + 8u +
+      count * sizeof(std::uint32_t));
+   if (size - chars_offset < chars_size)
+      return false;
+
+   // Offsets delimit consecutive strings and may not decrease, which with
+   // the last offset being chars_size keeps every string within the table
+   const auto offsets = data + h.strings_offset + 8u;
+   auto previous = load<std::uint32_t>(offsets);
+   for (auto i = 1u; i <= count; ++i)
+   {
+      const auto offset = load<std::uint32_t>(offsets + i * sizeof(std::uint32_t));
+      if (offset < previous)
+         return false;
+      previous = offset;
+   }
+
+   // Validate column directory and column data
+   if (h.columns_offset > size ||
+       (size - h.columns_offset) / sizeof(column_entry) < h.columns)
+      return false;
+   const auto presence_size = (h.rows + 7u) / 8u;
+   for (auto i = 0u; i < h.columns; ++i)
+   {
+      const auto entry = load<column_entry>(data + h.columns_offset + i * sizeof(column_entry));
+      const auto kind = static_cast<column_kind>(entry.kind);
+      const auto width = value_size(kind);
+      if (width == 0 || entry.name >= count ||
+          entry.presence_offset > size || size - entry.presence_offset < presence_size ||
+          entry.values_offset > size || (size - entry.values_offset) / width < h.rows)
+      {
+         columns_.clear();
+         return false;
+      }
+      columns_.push_back(column{ std::string(), kind,
+         reinterpret_cast<const std::uint8_t*>(data + entry.presence_offset),
+         data + entry.values_offset });
+   }
+
+   strings_ = data + h.strings_offset;
+   string_count_ = count;
+   rows_ = static_cast<std::size_t>(h.rows);
+   for (auto i = 0u; i < h.columns; ++i)
+   {
+      const auto entry = load<column_entry>(data + h.columns_offset + i * sizeof(column_entry));
+      columns_[i].name = string_at(entry.name);
+   }
+   return true;
+}
+
+std::size_t gb2gc::snapshot::rows() const noexcept
+{
+   return rows_;
+}
+
+std::size_t gb2gc::snapshot::cols() const noexcept
+{
+   return columns_.size();
+}
+
+std::size_t gb2gc::snapshot::size() const
+{
+   return rows_;
+}
+
+std::size_t gb2gc::snapshot::field(const std::string& name) const
+{
+   const auto found = std::find_if(columns_.begin(), columns_.end(),
+      [&](const column& c) { return c.name == name; });
+   return found == columns_.end() ? npos : static_cast<std::size_t>(found - columns_.begin());
+}
+
+gb2gc::field_value gb2gc::snapshot::value(std::size_t field, std::size_t index) const
+{
+   field_value result;
+   const auto& c = columns_[field];
+   if ((c.presence[index / 8u] & (1u << (index % 8u))) == 0)
+      return result;
+   const auto value = c.values + index * value_size(c.kind);
+   switch (c.kind)
+   {
+   case column_kind::boolean:
+      result.type = field_value::kind::boolean;
+      result.number = load<std::uint8_t>(value) != 0 ? 1.0 : 0.0;
+      break;
+   case column_kind::integer:
+      result.type = field_value::kind::number;
+      result.number = static_cast<double>(load<std::int64_t>(value));
+      break;
+   case column_kind::real:
+      result.type = field_value::kind::number;
+      result.number = load<double>(value);
+      break;
+   case column_kind::string:
+   {
+      // Refer to the mapped characters, out of range indices read as empty
+      const auto string_index = load<std::uint32_t>(value);
+      result.type = field_value::kind::string;
+      if (string_index < string_count_)
+         chars_at(string_index, result.data, result.size);
+      else
+         result.data = "";
+      break;
+   }
+   }
+   return result;
+}
+
+void gb2gc::snapshot::chars_at(std::uint32_t index, const char*& data, std::size_t& size) const
+{
+   const auto offsets = strings_ + 8u;
+   const auto chars = offsets + (string_count_ + 1u) * sizeof(std::uint32_t);
+   const auto first = load<std::uint32_t>(offsets + index * sizeof(std::uint32_t));
+   const auto last = load<std::uint32_t>(offsets + (index + 1u) * sizeof(std::uint32_t));
+   data = chars + first;
+   size = last - first;
+}
+
+std::string gb2gc::snapshot::string_at(std::uint32_t index) const
+{
+   const char* data;
+   std::size_t size;
+   chars_at(index, data, size);
+   return std::string(data, size);
+}
+
+void gb2gc::snapshot::read(const std::vector<std::string>& fields,
+   const callback& on_benchmark) const
+{
+   // Resolve fields to columns once instead of once per benchmark
+   std::vector<const column*> selected;
+   for (const auto& c : columns_)
+   {
+      if (fields.empty() || std::find(fields.begin(), fields.end(), c.name) != fields.end())
+         selected.push_back(&c);
+   }
+
+   for (auto row = 0u; row < rows_; ++row)
+   {
+      auto bm = nlohmann::json::object();
+      for (const auto c : selected)
+      {
+         if ((c->presence[row / 8u] & (1u << (row % 8u))) == 0)
+            continue;
+         const auto value = c->values + row * value_size(c->kind);
+         switch (c->kind)
+         {
+         case column_kind::boolean:
+            bm[c->name] = load<std::uint8_t>(value) != 0;
+            break;
+         case column_kind::integer:
+            bm[c->name] = load<std::int64_t>(value);
+            break;
+         case column_kind::real:
+            bm[c->name] = load<double>(value);
+            break;
+         case column_kind::string:
+         {
+            const auto index = load<std::uint32_t>(value);
+            bm[c->name] = index < string_count_ ? string_at(index) : std::string();
+            break;
+         }
+         }
+      }
+      on_benchmark(std::move(bm));
+   }
+}
@@ -0,0 +1,108 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_SNAPSHOT_H
+#define GB2GC_SNAPSHOT_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "benchmark_table.h"
+#include "mapped_file.h"
+
+namespace gb2gc
+{
+   // Identifies the exact content of an input file a snapshot was made from
+   struct input_signature
+   {
+      std::uint64_t size = 0;
+      std::int64_t  mtime = 0;
+      std::uint64_t hash = 0;
+
+      // Reads the signature of the given regular file. Returns false if the
+      // file cannot be read or is not a regular file, e.g. a pipe.
+      bool read(const std::string& path);
+
+      bool operator==(const input_signature& other) const noexcept;
+      bool operator!=(const input_signature& other) const noexcept;
+   };
+
+   // Returns a 64-bit hash of the given bytes
+   std::uint64_t hash_bytes(const char* data, std::size_t size) noexcept;
+
+   // Binary snapshot of parsed benchmark results. The snapshot stores each
+   // benchmark field as a typed column, i.e. booleans, 64-bit integers,
+   // doubles or string table indices, together with a presence bitmap
+   // since not all benchmarks have the same fields. Snapshots are memory
+   // mapped when read and are only valid for the exact input they were
+   // created from. As a benchmark_table, values are read directly from the
+   // mapped columns and strings refer to the mapped string table.
+   class snapshot final : public benchmark_table
+   {
+   public:
+      enum class column_kind : std::uint32_t
+      {
+         boolean = 0,
+         integer = 1,
+         real    = 2,
+         string  = 3
+      };
+
+      using callback = std::function<void(nlohmann::json&& benchmark)>;
+
+      // Returns the path of the snapshot associated with the given input
+      static std::string path_for(const std::string& input_path);
+
+      // Writes a snapshot of the given array of benchmarks created from an
+      // input with the given signature. Returns false if the benchmarks
+      // cannot be represented by a snapshot or the file cannot be written.
+      static bool write(const std::string& path, const input_signature& signature,
+         const nlohmann::json& benchmarks);
+
+      // Opens the given snapshot. Returns false if the snapshot do not exist,
+      // is corrupt or was not created from an input with the given signature.
+      bool open(const std::string& path, const input_signature& signature);
+
+      std::size_t rows() const noexcept;
+      std::size_t cols() const noexcept;
+
+      std::size_t size() const override;
+      std::size_t field(const std::string& name) const override;
+      field_value value(std::size_t field, std::size_t index) const override;
+
+      // Reconstructs each benchmark with the given fields, or all fields if
+      // no fields are specified, and hands it over to the given callback.
+      void read(const std::vector<std::string>& fields, const callback& on_benchmark) const;
+
+   private:
+      struct column
+      {
+         std::string         name;
+         column_kind         kind;
+         const std::uint8_t* presence;
+         const char*         values;
+      };
+
+      void chars_at(std::uint32_t index, const char*& data, std::size_t& size) const;
+      std::string string_at(std::uint32_t index) const;
+
+      std::vector<char>   buffer_; // fallback if memory mapping is not supported
+      mapped_file         map_;
+      const char*         strings_ = nullptr;
+      std::uint32_t       string_count_ = 0;
+      std::size_t         rows_ = 0;
+      std::vector<column> columns_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_SNAPSHOT_H
@@ -0,0 +1,315 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "stats_kernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define GB2GC_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// Vectorized kernels are compiled for their instruction set regardless of
+// the target architecture flags and only invoked if supported at runtime
+#if defined(GB2GC_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GB2GC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define GB2GC_TARGET(isa)
+#endif
+
+namespace
+{
+   ////////////////////////////////////////////////////////////////////////////
+   // scalar
+
+   double sum_scalar(const double* values, std::size_t n)
+   {
+      auto sum = 0.0;
+      for (auto i = std::size_t(0); i < n; ++i)
+         sum += values[i];
+      return sum;
+   }
+
+   double minimum_scalar(const double* values, std::size_t n)
+   {
+      auto result = values[0];
+      for (auto i = std::size_t(1); i < n; ++i)
+         result = values[i] < result ? values[i] : result;
+      return result;
+   }
+
+   double maximum_scalar(const double* values, std::size_t n)
+   {
+      auto result = values[0];
+      for (auto i = std::size_t(1); i < n; ++i)
+         result = values[i] > result ? values[i] : result;
+      return result;
+   }
+
+   double sum_squared_deviations_scalar(const double* values, std::size_t n, double mean)
+   {
+      auto sum = 0.0;
+      for (auto i = std::size_t(0); i < n; ++i)
+         sum += (values[i] - mean) * (values[i] - mean);
+      return sum;
+   }
+
+#ifdef GB2GC_X86
+
+   ////////////////////////////////////////////////////////////////////////////
+   // sse2, two accumulators of two lanes each
+
+   GB2GC_TARGET("sse2") double horizontal_sum(__m128d v)
+   {
+      return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+   }
+
+   GB2GC_TARGET("sse2") double sum_sse2(const double* values, std::size_t n)
+   {
+      auto acc0 = _mm_setzero_pd();
+      auto acc1 = _mm_setzero_pd();
+      auto i = std::size_t(0);
+      for (; i + 4 <= n; i += 4)
+      {
+         acc0 = _mm_add_pd(acc0, _mm_loadu_pd(values + i));
+         acc1 = _mm_add_pd(acc1, _mm_loadu_pd(values + i + 2));
+      }
+      auto sum = horizontal_sum(_mm_add_pd(acc0, acc1));
+      for (; i < n; ++i)
+         sum += values[i];
+      return sum;
+   }
+
+   GB2GC_TARGET("sse2") double minimum_sse2(const double* values, std::size_t n)
+   {
+      if (n < 4)
+         return minimum_scalar(values, n);
+      auto acc0 = _mm_loadu_pd(values);
+      auto acc1 = _mm_loadu_pd(values + 2);
+      auto i = std::size_t(4);
+      for (; i + 4 <= n; i += 4)
+      {
+         acc0 = _mm_min_pd(acc0, _mm_loadu_pd(values + i));
+         acc1 = _mm_min_pd(acc1, _mm_loadu_pd(values + i + 2));
+      }
+      acc0 = _mm_min_pd(acc0, acc1);
+      acc0 = _mm_min_sd(acc0, _mm_unpackhi_pd(acc0, acc0));
+      auto result = _mm_cvtsd_f64(acc0);
+      for (; i < n; ++i)
+         result = values[i] < result ? values[i] : result;
+      return result;
+   }
+
+   GB2GC_TARGET("sse2") double maximum_sse2(const double* values, std::size_t n)
+   {
+      if (n < 4)
+         return maximum_scalar(values, n);
+      auto acc0 = _mm_loadu_pd(values);
+      auto acc1 = _mm_loadu_pd(values + 2);
+      auto i = std::size_t(4);
+      for (; i + 4 <= n; i += 4)
+      {
+         acc0 = _mm_max_pd(acc0, _mm_loadu_pd(values + i));
+         acc1 = _mm_max_pd(acc1, _mm_loadu_pd(values + i + 2));
+      }
+      acc0 = _mm_max_pd(acc0, acc1);
+      acc0 = _mm_max_sd(acc0, _mm_unpackhi_pd(acc0, acc0));
+      auto result = _mm_cvtsd_f64(acc0);
+      for (; i < n; ++i)
+         result = values[i] > result ? values[i] : result;
+      return result;
+   }
+
+   GB2GC_TARGET("sse2") double sum_squared_deviations_sse2(
+      const double* values, std::size_t n, double mean)
+   {
+      const auto m = _mm_set1_pd(mean);
+      auto acc0 = _mm_setzero_pd();
+      auto acc1 = _mm_setzero_pd();
+      auto i = std::size_t(0);
+      for (; i + 4 <= n; i += 4)
+      {
+         const auto d0 = _mm_sub_pd(_mm_loadu_pd(values + i), m);
+         const auto d1 = _mm_sub_pd(_mm_loadu_pd(values + i + 2), m);
+         acc0 = _mm_add_pd(acc0, _mm_mul_pd(d0, d0));
+         acc1 = _mm_add_pd(acc1, _mm_mul_pd(d1, d1));
+      }
+      auto sum = horizontal_sum(_mm_add_pd(acc0, acc1));
+      for (; i < n; ++i)
+         sum += (values[i] - mean) * (values[i] - mean);
+      return sum;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   // avx2, two accumulators of four lanes each
+
+   GB2GC_TARGET("avx2") double horizontal_sum(__m256d v)
+   {
+      const auto pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+      return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+   }
+
+   GB2GC_TARGET("avx2") double sum_avx2(const double* values, std::size_t n)
+   {
+      auto acc0 = _mm256_setzero_pd();
+      auto acc1 = _mm256_setzero_pd();
+      auto i = std::size_t(0);
+      for (; i + 8 <= n; i += 8)
+      {
+         acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+         acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+      }
+      auto sum = horizontal_sum(_mm256_add_pd(acc0, acc1));
+      for (; i < n; ++i)
+         sum += values[i];
+      return sum;
+   }
+
+   GB2GC_TARGET("avx2") double minimum_avx2(const double* values, std::size_t n)
+   {
+      if (n < 8)
+         return minimum_scalar(values, n);
+      auto acc0 = _mm256_loadu_pd(values);
+      auto acc1 = _mm256_loadu_pd(values + 4);
+      auto i = std::size_t(8);
+      for (; i + 8 <= n; i += 8)
+      {
+         acc0 = _mm256_min_pd(acc0, _mm256_loadu_pd(values + i));
+         acc1 = _mm256_min_pd(acc1, _mm256_loadu_pd(values + i + 4));
+      }
+      acc0 = _mm256_min_pd(acc0, acc1);
+      auto pair = _mm_min_pd(_mm256_castpd256_pd128(acc0), _mm256_extractf128_pd(acc0, 1));
+      pair = _mm_min_sd(pair, _mm_unpackhi_pd(pair, pair));
+      auto result = _mm_cvtsd_f64(pair);
+      for (; i < n; ++i)
+         result = values[i] < result ? values[i] : result;
+      return result;
+   }
+
+   GB2GC_TARGET("avx2") double maximum_avx2(const double* values, std::size_t n)
+   {
+      if (n < 8)
+         return maximum_scalar(values, n);
+      auto acc0 = _mm256_loadu_pd(values);
+      auto acc1 = _mm256_loadu_pd(values + 4);
+      auto i = std::size_t(8);
+      for (; i + 8 <= n; i += 8)
+      {
+         acc0 = _mm256_max_pd(acc0, _mm256_loadu_pd(values + i));
+         acc1 = _mm256_max_pd(acc1, _mm256_loadu_pd(values + i + 4));
+      }
+      acc0 = _mm256_max_pd(acc0, acc1);
+      auto pair = _mm_max_pd(_mm256_castpd256_pd128(acc0), _mm256_extractf128_pd(acc0, 1));
+      pair = _mm_max_sd(pair, _mm_unpackhi_pd(pair, pair));
+      auto result = _mm_cvtsd_f64(pair);
+      for (; i < n; ++i)
+         result = values[i] > result ? values[i] : result;
+      return result;
+   }
+
+   GB2GC_TARGET("avx2") double sum_squared_deviations_avx2(
+      const double* values, std::size_t n, double mean)
+   {
+      const auto m = _mm256_set1_pd(mean);
+      auto acc0 = _mm256_setzero_pd();
+      auto acc1 = _mm256_setzero_pd();
+      auto i = std::size_t(0);
+      for (; i + 8 <= n; i += 8)
+      {
+         const auto d0 = _mm256_sub_pd(_mm256_loadu_pd(values + i), m);
+         const auto d1 = _mm256_sub_pd(_mm256_loadu_pd(values + i + 4), m);
+         acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+         acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+      }
+      auto sum = horizontal_sum(_mm256_add_pd(acc0, acc1));
+      for (; i < n; ++i)
+         sum += (values[i] - mean) * (values[i] - mean);
+      return sum;
+   }
+
+   bool supports_avx2() noexcept
+   {
+#ifdef _MSC_VER
+      int info[4];
+      __cpuid(info, 0);
+      if (info[0] < 7)
+         return false;
+      __cpuid(info, 1);
+      const auto osxsave = (info[2] & (1 << 27)) != 0;
+      const auto avx = (info[2] & (1 << 28)) != 0;
+      if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) // OS saves YMM state
+         return false;
+      __cpuidex(info, 7, 0);
+      return (info[1] & (1 << 5)) != 0;
+#else
+      return __builtin_cpu_supports("avx2") != 0;
+#endif
+   }
+
+   bool supports_sse2() noexcept
+   {
+#if defined(_M_X64) || defined(__x86_64__)
+      return true; // part of the x86-64 baseline
+#elif defined(_MSC_VER)
+      int info[4];
+      __cpuid(info, 1);
+      return (info[3] & (1 << 26)) != 0;
+#else
+      return __builtin_cpu_supports("sse2") != 0;
+#endif
+   }
+
+#endif // GB2GC_X86
+
+   const gb2gc::stats_kernels scalar_kernels = {
+      gb2gc::instruction_set::scalar,
+      sum_scalar, minimum_scalar, maximum_scalar, sum_squared_deviations_scalar
+   };
+
+#ifdef GB2GC_X86
+   const gb2gc::stats_kernels sse2_kernels = {
+      gb2gc::instruction_set::sse2,
+      sum_sse2, minimum_sse2, maximum_sse2, sum_squared_deviations_sse2
+   };
+
+   const gb2gc::stats_kernels avx2_kernels = {
+      gb2gc::instruction_set::avx2,
+      sum_avx2, minimum_avx2, maximum_avx2, sum_squared_deviations_avx2
+   };
+#endif
+}
+
+gb2gc::instruction_set gb2gc::supported_instruction_set() noexcept
+{
+#ifdef GB2GC_X86
+   if (supports_avx2())
+      return instruction_set::avx2;
+   if (supports_sse2())
+      return instruction_set::sse2;
+#endif
+   return instruction_set::scalar;
+}
+
+const gb2gc::stats_kernels& gb2gc::get_stats_kernels(instruction_set isa) noexcept
+{
+   const auto supported = supported_instruction_set();
+   if (static_cast<int>(isa) > static_cast<int>(supported))
+      isa = supported;
+#ifdef GB2GC_X86
+   if (isa == instruction_set::avx2)
+      return avx2_kernels;
+   if (isa == instruction_set::sse2)
+      return sse2_kernels;
+#endif
+   return scalar_kernels;
+}
+
+const gb2gc::stats_kernels& gb2gc::get_stats_kernels() noexcept
+{
+   // Detected once, function-local statics are initialized thread-safely
+   static const stats_kernels& kernels = get_stats_kernels(supported_instruction_set());
+   return kernels;
+}
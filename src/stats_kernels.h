@@ -0,0 +1,48 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_STATS_KERNELS_H
+#define GB2GC_STATS_KERNELS_H
+
+#include <cstddef>
+
+namespace gb2gc
+{
+   enum class instruction_set
+   {
+      scalar,
+      sse2,
+      avx2
+   };
+
+   // Reductions over contiguous arrays of doubles. Vectorized kernels
+   // accumulate in several lanes, hence sums may differ from a sequential
+   // sum by rounding. Minimum and maximum require at least one value and
+   // do not order NaN.
+   struct stats_kernels
+   {
+      instruction_set isa;
+      double (*sum)(const double* values, std::size_t n);
+      double (*minimum)(const double* values, std::size_t n);
+      double (*maximum)(const double* values, std::size_t n);
+      double (*sum_squared_deviations)(const double* values, std::size_t n, double mean);
+   };
+
+   // Returns the most capable instruction set supported by the executing CPU
+   instruction_set supported_instruction_set() noexcept;
+
+   // Returns the kernels for the given instruction set, or the kernels of the
+   // most capable supported instruction set if the given one is not supported
+   const stats_kernels& get_stats_kernels(instruction_set isa) noexcept;
+
+   // Returns the kernels of the most capable supported instruction set
+   const stats_kernels& get_stats_kernels() noexcept;
+
+} // namespace gb2gc
+
+#endif // GB2GC_STATS_KERNELS_H
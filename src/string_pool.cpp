@@ -0,0 +1,114 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "string_pool.h"
+
+#include <cstring>
+
+namespace
+{
+   constexpr std::size_t block_size = 64 * 1024;
+}
+
+constexpr gb2gc::string_pool::code_type gb2gc::string_pool::npos;
+
+std::size_t gb2gc::string_pool::key_hash::operator()(const key& k) const noexcept
+{
+   // FNV-1a, pooled strings are typically short
+   std::uint64_t h = 14695981039346656037ull;
+   for (auto i = std::size_t(0); i < k.size; ++i)
+   {
+      h ^= static_cast<unsigned char>(k.data[i]);
+      h *= 1099511628211ull;
+   }
+   return static_cast<std::size_t>(h);
+}
+
+bool gb2gc::string_pool::key_equal::operator()(const key& lhs, const key& rhs) const noexcept
+{
+   return lhs.size == rhs.size && std::memcmp(lhs.data, rhs.data, lhs.size) == 0;
+}
+
+gb2gc::string_pool::string_pool()
+   : free_(nullptr), available_(0)
+{ }
+
+const char* gb2gc::string_pool::store(const char* data, std::size_t size)
+{
+   const auto required = size + 1; // null-terminated
+   if (required > available_)
+   {
+      // Strings larger than a block get a dedicated block, the current
+      // block is kept for subsequent small strings
+      if (required > block_size / 4)
+      {
+         blocks_.emplace_back(new char[required]);
+         auto dst = blocks_.back().get();
+         std::memcpy(dst, data, size);
+         dst[size] = '\0';
+         return dst;
+      }
+      blocks_.emplace_back(new char[block_size]);
+      free_ = blocks_.back().get();
+      available_ = block_size;
+   }
+
+   auto dst = free_;
+   std::memcpy(dst, data, size);
+   dst[size] = '\0';
+   free_ += required;
+   available_ -= required;
+   return dst;
+}
+
+gb2gc::string_pool::code_type gb2gc::string_pool::intern(const char* data, std::size_t size)
+{
+   const auto found = index_.find(key{ data, size });
+   if (found != index_.end())
+      return found->second;
+
+   const auto code = static_cast<code_type>(strings_.size());
+   const key stored{ store(data, size), size };
+   strings_.emplace_back(stored);
+   index_.emplace(stored, code);
+   return code;
+}
+
+gb2gc::string_pool::code_type gb2gc::string_pool::intern(const std::string& s)
+{
+   return intern(s.data(), s.size());
+}
+
+gb2gc::string_pool::code_type
+gb2gc::string_pool::find(const char* data, std::size_t size) const noexcept
+{
+   const auto found = index_.find(key{ data, size });
+   return found == index_.end() ? npos : found->second;
+}
+
+gb2gc::string_pool::code_type gb2gc::string_pool::find(const std::string& s) const noexcept
+{
+   return find(s.data(), s.size());
+}
+
+const char* gb2gc::string_pool::data(code_type code) const noexcept
+{
+   return strings_[code].data;
+}
+
+std::size_t gb2gc::string_pool::size(code_type code) const noexcept
+{
+   return strings_[code].size;
+}
+
+std::string gb2gc::string_pool::str(code_type code) const
+{
+   const auto& s = strings_.at(code);
+   return std::string(s.data, s.size);
+}
+
+std::size_t gb2gc::string_pool::count() const noexcept
+{
+   return strings_.size();
+}
@@ -0,0 +1,82 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_STRING_POOL_H
+#define GB2GC_STRING_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gb2gc
+{
+   // Deduplicated pool of strings identified by dense 32-bit codes. Strings
+   // are stored null-terminated in large arena blocks which are never
+   // relocated, hence pointers to pooled strings stay valid for the lifetime
+   // of the pool and lookups do not allocate.
+   class string_pool final
+   {
+   public:
+      using code_type = std::uint32_t;
+
+      // Code returned when looking up a string that is not in the pool
+      static constexpr code_type npos = UINT32_MAX;
+
+      string_pool();
+      string_pool(const string_pool&) = delete;
+      string_pool& operator=(const string_pool&) = delete;
+      string_pool(string_pool&&) = default;
+      string_pool& operator=(string_pool&&) = default;
+
+      // Returns the code of the given string, adding it to the pool if needed
+      code_type intern(const char* data, std::size_t size);
+      code_type intern(const std::string& s);
+
+      // Returns the code of the given string or npos if not in the pool
+      code_type find(const char* data, std::size_t size) const noexcept;
+      code_type find(const std::string& s) const noexcept;
+
+      const char* data(code_type code) const noexcept;
+      std::size_t size(code_type code) const noexcept;
+      std::string str(code_type code) const;
+
+      // Returns the number of distinct strings in the pool
+      std::size_t count() const noexcept;
+
+   private:
+      struct key
+      {
+         const char* data;
+         std::size_t size;
+      };
+
+      struct key_hash
+      {
+         std::size_t operator()(const key& k) const noexcept;
+      };
+
+      struct key_equal
+      {
+         bool operator()(const key& lhs, const key& rhs) const noexcept;
+      };
+
+      const char* store(const char* data, std::size_t size);
+
+      std::vector<std::unique_ptr<char[]>>                  blocks_;
+      char*                                                 free_;
+      std::size_t                                           available_;
+      std::vector<key>                                      strings_;
+      std::unordered_map<key, code_type, key_hash, key_equal> index_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_STRING_POOL_H
@@ -0,0 +1,690 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "svg_chart.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+   using visualization = gb2gc::googlechart::visualization;
+   using position = gb2gc::googlechart_options::position;
+
+   // Default series colors, same as Google Charts
+   const char* const palette[] =
+   {
+      "#3366cc", "#dc3912", "#ff9900", "#109618", "#990099",
+      "#0099c6", "#dd4477", "#66aa00", "#b82e2e", "#316395"
+   };
+
+   const double nan = std::numeric_limits<double>::quiet_NaN();
+
+   // Returns the given pixel coordinate or length rounded to 1/100 pixel
+   std::string px(double value)
+   {
+      char number[gb2gc::max_number_chars];
+      const auto rounded = std::round(value * 100.0) / 100.0;
+      return std::string(number, gb2gc::format_number(number, rounded == 0.0 ? 0.0 : rounded));
+   }
+
+   std::string to_string(double value)
+   {
+      char number[gb2gc::max_number_chars];
+      return std::string(number, gb2gc::format_number(number, value));
+   }
+
+   // Returns the given text escaped for XML character data and attributes
+   std::string escape_xml(const std::string& s)
+   {
+      std::string escaped;
+      escaped.reserve(s.size());
+      for (const auto c : s)
+      {
+         switch (c)
+         {
+         case '&':  escaped += "&amp;"; break;
+         case '<':  escaped += "&lt;"; break;
+         case '>':  escaped += "&gt;"; break;
+         case '"':  escaped += "&quot;"; break;
+         case '\'': escaped += "&apos;"; break;
+         default:   escaped += c; break;
+         }
+      }
+      return escaped;
+   }
+
+   std::string to_hex(const gb2gc::color& c)
+   {
+      static const char digits[] = "0123456789abcdef";
+      std::string hex("#");
+      for (const auto v : { c.r, c.g, c.b })
+      {
+         hex += digits[v >> 4];
+         hex += digits[v & 0xf];
+      }
+      return hex;
+   }
+
+   // Ticks of an axis covering a value range with round tick values
+   struct ticks
+   {
+      std::vector<double> values;
+
+      double min() const { return values.front(); }
+      double max() const { return values.back(); }
+   };
+
+   // Returns about count + 1 ticks with a step of 1, 2 or 5 times a power of
+   // ten covering [min, max]. Tick values are computed from integers such
+   // that they format without rounding noise.
+   ticks make_ticks(double min, double max, size_t count)
+   {
+      if (!(min < max))
+      {  // expand empty range
+         const auto d = min == 0.0 ? 1.0 : std::fabs(min) * 0.5;
+         min = (std::max)(min - d, std::numeric_limits<double>::lowest());
+         max = (std::min)(max + d, (std::numeric_limits<double>::max)());
+      }
+      // Divided before subtracting since max - min may overflow
+      const auto n = static_cast<double>(count);
+      const auto raw = max / n - min / n;
+      ticks t;
+      if (std::isfinite(raw) && raw > 0.0)
+      {
+         const auto exponent = static_cast<int>(std::floor(std::log10(raw)));
+         const auto scale = std::pow(10.0, std::abs(exponent));
+         const auto fraction = exponent < 0 ? raw * scale : raw / scale;
+         const auto step = fraction <= 1.0 ? 1.0 : fraction <= 2.0 ? 2.0 : fraction <= 5.0 ? 5.0 : 10.0;
+         const auto unscale = [&](double k) { return exponent < 0 ? k * step / scale : k * step * scale; };
+         const auto rescale = [&](double v) { return exponent < 0 ? v * scale / step : v / (scale * step); };
+         const auto first = std::floor(rescale(min) + 1e-9);
+         const auto last = std::ceil(rescale(max) - 1e-9);
+
+         const auto exact = 4503599627370496.0; // 2^52, consecutive integers are exact
+         if (std::fabs(first) < exact && std::fabs(last) < exact && last - first <= n + 2.0 &&
+             std::isfinite(unscale(first)) && std::isfinite(unscale(last)))
+         {
+            const auto steps = static_cast<size_t>(last - first);
+            for (auto k = size_t(0); k <= steps; ++k)
+               t.values.emplace_back(unscale(first + static_cast<double>(k)));
+            if (t.values.size() < 2)
+               t.values.emplace_back(unscale(first + 1.0));
+            return t;
+         }
+      }
+
+      // The range is too narrow relative to its magnitude to be divided into
+      // round steps, e.g. keys beyond 2^53 differing in their last bits, or
+      // the round steps would exceed the range of double. Ticks are spread
+      // evenly instead, skipping ticks rounding to the value of the previous
+      // tick.
+      for (auto k = size_t(0); k <= count; ++k)
+      {
+         const auto value = k == count ? max : min + static_cast<double>(k) * raw;
+         if (t.values.empty() || value > t.values.back())
+            t.values.emplace_back(value);
+      }
+      if (t.values.size() < 2)
+         t.values.emplace_back(max);
+      return t;
+   }
+
+   // Linear mapping of values in [min, max] to pixels in [from, to]
+   struct scale
+   {
+      double min;
+      double max;
+      double from;
+      double to;
+
+      double operator()(double value) const
+      {
+         // Halved since value - min and max - min may overflow
+         return from + (value * 0.5 - min * 0.5) / (max * 0.5 - min * 0.5) * (to - from);
+      }
+   };
+
+   struct series_data
+   {
+      std::string         name;
+      std::string         color;
+      std::vector<double> values; // NaN if missing
+   };
+
+   // Data of the chart extracted from the view
+   struct chart_data
+   {
+      std::vector<std::string> labels; // key labels
+      std::vector<double>      keys;   // key values, NaN if not a number
+      bool                     numeric_keys = true;
+      std::vector<series_data> series;
+   };
+
+   chart_data extract(const gb2gc::data_set_view& view,
+      const gb2gc::googlechart_options& options)
+   {
+      chart_data data;
+      const auto rows = view.rows();
+      if (view.cols() == 0)
+         return data;
+
+      data.labels.resize(rows);
+      data.keys.resize(rows, nan);
+      const auto& key_column = view.get_col(0);
+      for (auto row = size_t(0); row < rows; ++row)
+      {
+         const auto index = view.row_index(row);
+         const auto value = key_column[index];
+         if (value.index() == 12)
+            data.labels[row] = nonstd::get<12>(value);
+         else if (value.index() != 0)
+            data.labels[row] = gb2gc::to_string(value);
+         if (!key_column.number(index, data.keys[row]) || std::isnan(data.keys[row]))
+         {
+            data.keys[row] = nan;
+            data.numeric_keys = false;
+         }
+      }
+
+      for (auto col = size_t(1); col < view.cols(); ++col)
+      {
+         const auto& column = view.get_col(col);
+         series_data s;
+         s.name = column.name();
+         const auto i = col - 1;
+         s.color = i < options.colors.size() ? to_hex(options.colors[i]) :
+            palette[i % (sizeof(palette) / sizeof(palette[0]))];
+         s.values.resize(rows, nan);
+         for (auto row = size_t(0); row < rows; ++row)
+         {
+            if (!column.number(view.row_index(row), s.values[row]))
+               s.values[row] = nan;
+         }
+         data.series.emplace_back(std::move(s));
+      }
+      return data;
+   }
+
+   // Returns the range of the given axis, overridden by its min and max values
+   void apply_axis(const gb2gc::axis& axis, double& min, double& max)
+   {
+      double value;
+      if (gb2gc::to_number(axis.min_value, value))
+         min = value;
+      if (gb2gc::to_number(axis.max_value, value))
+         max = value;
+   }
+
+   // Returns the range of all series values, including zero if requested
+   void value_range(const chart_data& data, bool include_zero,
+      double& min, double& max)
+   {
+      min = std::numeric_limits<double>::infinity();
+      max = -std::numeric_limits<double>::infinity();
+      for (const auto& s : data.series)
+      {
+         for (const auto v : s.values)
+         {
+            if (std::isnan(v) || std::isinf(v))
+               continue;
+            min = (std::min)(min, v);
+            max = (std::max)(max, v);
+         }
+      }
+      if (min > max)
+      {
+         min = 0.0;
+         max = 1.0;
+      }
+      if (include_zero)
+      {
+         min = (std::min)(min, 0.0);
+         max = (std::max)(max, 0.0);
+      }
+   }
+
+   // Plot area of the chart in pixels
+   struct plot_area
+   {
+      double left;
+      double top;
+      double right;
+      double bottom;
+   };
+
+   class renderer
+   {
+   public:
+      renderer(gb2gc::html_writer& svg, const gb2gc::svgchart& chart,
+         const chart_data& data)
+         : svg_(svg), chart_(chart), data_(data), area_()
+      { }
+
+      void render();
+
+   private:
+      void layout();
+      void text(double x, double y, const std::string& value,
+         const char* anchor = "start", const char* transform = nullptr);
+      void line(double x1, double y1, double x2, double y2, const char* stroke);
+      void rect(double x, double y, double w, double h, const std::string& fill);
+      void opacity();
+
+      void value_ticks_vertical(const ticks& t, const scale& y);
+      void value_ticks_horizontal(const ticks& t, const scale& x);
+      void axis_titles();
+      void legend();
+
+      void render_line_or_scatter(bool lines);
+      void render_bar();
+      void render_histogram();
+
+      gb2gc::html_writer&      svg_;
+      const gb2gc::svgchart&   chart_;
+      const chart_data&        data_;
+      plot_area                area_;
+   };
+
+   const double legend_width = 160.0;
+   const double legend_height = 25.0;
+
+   void renderer::layout()
+   {
+      const auto& options = chart_.options;
+      area_.left = 70.0;
+      area_.top = options.title.empty() ? 20.0 : 45.0;
+      area_.right = static_cast<double>(chart_.width) - 20.0;
+      area_.bottom = static_cast<double>(chart_.height) - 50.0;
+      switch (options.legend)
+      {
+      case position::left:   area_.left += legend_width; break;
+      case position::right:  area_.right -= legend_width; break;
+      case position::top:    area_.top += legend_height; break;
+      case position::bottom: area_.bottom -= legend_height; break;
+      case position::none:
+      default:               break;
+      }
+      area_.right = (std::max)(area_.right, area_.left + 1.0);
+      area_.bottom = (std::max)(area_.bottom, area_.top + 1.0);
+   }
+
+   void renderer::text(double x, double y, const std::string& value,
+      const char* anchor, const char* transform)
+   {
+      svg_.open("text").attr("x", px(x)).attr("y", px(y));
+      if (std::string(anchor) != "start")
+         svg_.attr("text-anchor", anchor);
+      if (transform)
+         svg_.attr("transform", transform);
+      svg_.inline_text(escape_xml(value));
+   }
+
+   void renderer::line(double x1, double y1, double x2, double y2, const char* stroke)
+   {
+      svg_.open("line")
+         .attr("x1", px(x1)).attr("y1", px(y1))
+         .attr("x2", px(x2)).attr("y2", px(y2))
+         .attr("stroke", stroke)
+         .close();
+   }
+
+   void renderer::rect(double x, double y, double w, double h, const std::string& fill)
+   {
+      svg_.open("rect")
+         .attr("x", px(x)).attr("y", px(y))
+         .attr("width", px(w)).attr("height", px(h))
+         .attr("fill", fill);
+      opacity();
+      svg_.close();
+   }
+
+   void renderer::opacity()
+   {
+      if (chart_.options.data_opacity != 1.0f)
+         svg_.attr("opacity", to_string(chart_.options.data_opacity));
+   }
+
+   void renderer::value_ticks_vertical(const ticks& t, const scale& y)
+   {
+      for (const auto v : t.values)
+      {
+         const auto py = y(v);
+         line(area_.left, py, area_.right, py, v == 0.0 ? "#333333" : "#cccccc");
+         text(area_.left - 6.0, py + 4.0, to_string(v), "end");
+      }
+   }
+
+   void renderer::value_ticks_horizontal(const ticks& t, const scale& x)
+   {
+      for (const auto v : t.values)
+      {
+         const auto px_ = x(v);
+         line(px_, area_.top, px_, area_.bottom, v == 0.0 ? "#333333" : "#cccccc");
+         text(px_, area_.bottom + 18.0, to_string(v), "middle");
+      }
+   }
+
+   void renderer::axis_titles()
+   {
+      const auto& options = chart_.options;
+      if (!options.horizontal_axis.title.empty())
+      {
+         text((area_.left + area_.right) / 2.0, area_.bottom + 40.0,
+            options.horizontal_axis.title, "middle");
+      }
+      if (!options.vertical_axis.title.empty())
+      {
+         const auto x = area_.left - 55.0;
+         const auto y = (area_.top + area_.bottom) / 2.0;
+         const auto transform = "rotate(-90 " + px(x) + " " + px(y) + ")";
+         text(x, y, options.vertical_axis.title, "middle", transform.c_str());
+      }
+   }
+
+   void renderer::legend()
+   {
+      const auto pos = chart_.options.legend;
+      if (pos == position::none || data_.series.empty())
+         return;
+
+      const auto vertical = pos == position::left || pos == position::right;
+      auto x = pos == position::left ? 10.0 :
+         pos == position::right ? area_.right + 15.0 : area_.left;
+      auto y = pos == position::top ? area_.top - legend_height + 5.0 :
+         pos == position::bottom ? area_.bottom + 55.0 : area_.top;
+      svg_.open("g");
+      for (const auto& s : data_.series)
+      {
+         rect(x, y, 12.0, 12.0, s.color);
+         text(x + 18.0, y + 10.0, s.name);
+         if (vertical)
+            y += 20.0;
+         else
+            x += 30.0 + 7.0 * static_cast<double>(s.name.size());
+      }
+      svg_.close();
+   }
+
+   void renderer::render_line_or_scatter(bool lines)
+   {
+      const auto& options = chart_.options;
+      const auto rows = data_.labels.size();
+
+      // Horizontal axis, numeric keys are laid out by value, other keys at
+      // equal distances in order
+      double x_min = 0.0;
+      double x_max = rows > 1 ? static_cast<double>(rows - 1) : 1.0;
+      ticks x_ticks;
+      if (data_.numeric_keys && rows != 0)
+      {
+         x_min = *std::min_element(data_.keys.begin(), data_.keys.end());
+         x_max = *std::max_element(data_.keys.begin(), data_.keys.end());
+         apply_axis(options.horizontal_axis, x_min, x_max);
+         x_ticks = make_ticks(x_min, x_max, 5);
+         x_min = x_ticks.min();
+         x_max = x_ticks.max();
+      }
+      else if (rows == 1)
+      {
+         x_min = -1.0;
+      }
+      const scale x{ x_min, x_max, area_.left, area_.right };
+      const auto key = [&](size_t row)
+      {
+         return data_.numeric_keys ? data_.keys[row] : static_cast<double>(row);
+      };
+
+      double y_min;
+      double y_max;
+      value_range(data_, false, y_min, y_max);
+      apply_axis(options.vertical_axis, y_min, y_max);
+      const auto y_ticks = make_ticks(y_min, y_max, 5);
+      const scale y{ y_ticks.min(), y_ticks.max(), area_.bottom, area_.top };
+
+      svg_.open("g").attr("font-size", "11").attr("fill", "#444444");
+      value_ticks_vertical(y_ticks, y);
+      if (data_.numeric_keys)
+      {
+         for (const auto v : x_ticks.values)
+            text(x(v), area_.bottom + 18.0, to_string(v), "middle");
+      }
+      else
+      {  // label at most about 10 keys
+         const auto step = (std::max)(size_t(1), (rows + 9) / 10);
+         for (auto row = size_t(0); row < rows; row += step)
+            text(x(key(row)), area_.bottom + 18.0, data_.labels[row], "middle");
+      }
+      svg_.close();
+      line(area_.left, area_.bottom, area_.right, area_.bottom, "#333333");
+
+      const auto radius = (options.point_size > 0.0f ?
+         static_cast<double>(options.point_size) : (lines ? 0.0 : 7.0)) / 2.0;
+      for (const auto& s : data_.series)
+      {
+         svg_.open("g");
+         if (lines)
+         {  // a polyline per run of values, nulls break lines unless interpolated
+            std::string points;
+            const auto flush = [&]()
+            {
+               if (points.empty())
+                  return;
+               svg_.open("polyline")
+                  .attr("points", points)
+                  .attr("fill", "none")
+                  .attr("stroke", s.color)
+                  .attr("stroke-width", "2");
+               opacity();
+               svg_.close();
+               points.clear();
+            };
+            for (auto row = size_t(0); row < rows; ++row)
+            {
+               if (std::isnan(s.values[row]) || std::isnan(key(row)))
+               {
+                  if (!options.interpolate_nulls)
+                     flush();
+                  continue;
+               }
+               if (!points.empty())
+                  points += ' ';
+               points += px(x(key(row)));
+               points += ',';
+               points += px(y(s.values[row]));
+            }
+            flush();
+         }
+         if (radius > 0.0)
+         {
+            for (auto row = size_t(0); row < rows; ++row)
+            {
+               if (std::isnan(s.values[row]) || std::isnan(key(row)))
+                  continue;
+               svg_.open("circle")
+                  .attr("cx", px(x(key(row))))
+                  .attr("cy", px(y(s.values[row])))
+                  .attr("r", px(radius))
+                  .attr("fill", s.color);
+               opacity();
+               svg_.close();
+            }
+         }
+         svg_.close();
+      }
+   }
+
+   void renderer::render_bar()
+   {
+      const auto& options = chart_.options;
+      const auto rows = data_.labels.size();
+
+      double v_min;
+      double v_max;
+      value_range(data_, true, v_min, v_max);
+      apply_axis(options.horizontal_axis, v_min, v_max);
+      const auto v_ticks = make_ticks(v_min, v_max, 5);
+      const scale x{ v_ticks.min(), v_ticks.max(), area_.left, area_.right };
+
+      // Each key is a category band with a bar per series
+      const auto band = (area_.bottom - area_.top) / static_cast<double>((std::max)(rows, size_t(1)));
+      const auto bar = band * 0.8 / static_cast<double>((std::max)(data_.series.size(), size_t(1)));
+
+      svg_.open("g").attr("font-size", "11").attr("fill", "#444444");
+      value_ticks_horizontal(v_ticks, x);
+      for (auto row = size_t(0); row < rows; ++row)
+      {
+         text(area_.left - 6.0, area_.top + band * (static_cast<double>(row) + 0.5) + 4.0,
+            data_.labels[row], "end");
+      }
+      svg_.close();
+      line(area_.left, area_.top, area_.left, area_.bottom, "#333333");
+
+      const auto zero = x((std::max)(v_ticks.min(), (std::min)(0.0, v_ticks.max())));
+      for (auto i = size_t(0); i < data_.series.size(); ++i)
+      {
+         const auto& s = data_.series[i];
+         svg_.open("g");
+         for (auto row = size_t(0); row < rows; ++row)
+         {
+            const auto v = s.values[row];
+            if (std::isnan(v))
+               continue;
+            const auto end = x(v);
+            rect((std::min)(zero, end),
+               area_.top + band * static_cast<double>(row) + band * 0.1 + bar * static_cast<double>(i),
+               std::fabs(end - zero), bar, s.color);
+         }
+         svg_.close();
+      }
+   }
+
+   void renderer::render_histogram()
+   {
+      const auto& options = chart_.options;
+
+      // Bucket all values of all series into about sqrt(n) buckets of a
+      // round width
+      double v_min;
+      double v_max;
+      value_range(data_, false, v_min, v_max);
+      apply_axis(options.horizontal_axis, v_min, v_max);
+      auto n = size_t(0);
+      for (const auto& s : data_.series)
+         n += static_cast<size_t>(std::count_if(s.values.begin(), s.values.end(),
+            [](double v) { return !std::isnan(v); }));
+      const auto bucket_count = (std::min)((std::max)(static_cast<size_t>(
+         std::ceil(std::sqrt(static_cast<double>(n)))), size_t(1)), size_t(30));
+      const auto edges = make_ticks(v_min, v_max, bucket_count);
+      const auto buckets = edges.values.size() - 1;
+      const auto width = edges.values[1] - edges.values[0];
+
+      std::vector<std::vector<size_t>> counts(data_.series.size(), std::vector<size_t>(buckets, 0));
+      auto max_count = size_t(1);
+      for (auto i = size_t(0); i < data_.series.size(); ++i)
+      {
+         for (const auto v : data_.series[i].values)
+         {
+            if (std::isnan(v) || v < edges.min() || v > edges.max())
+               continue;
+            const auto b = (std::min)(static_cast<size_t>((v - edges.min()) / width), buckets - 1);
+            max_count = (std::max)(max_count, ++counts[i][b]);
+         }
+      }
+
+      const scale x{ edges.min(), edges.max(), area_.left, area_.right };
+      double c_min = 0.0;
+      auto c_max = static_cast<double>(max_count);
+      apply_axis(options.vertical_axis, c_min, c_max);
+      const auto c_ticks = make_ticks(c_min, c_max, 5);
+      const scale y{ c_ticks.min(), c_ticks.max(), area_.bottom, area_.top };
+
+      svg_.open("g").attr("font-size", "11").attr("fill", "#444444");
+      value_ticks_vertical(c_ticks, y);
+      const auto label_step = (std::max)(size_t(1), (edges.values.size() + 9) / 10);
+      for (auto i = size_t(0); i < edges.values.size(); i += label_step)
+         text(x(edges.values[i]), area_.bottom + 18.0, to_string(edges.values[i]), "middle");
+      svg_.close();
+
+      const auto bucket_px = x(edges.values[1]) - x(edges.values[0]);
+      const auto bar = bucket_px * 0.9 / static_cast<double>((std::max)(data_.series.size(), size_t(1)));
+      for (auto i = size_t(0); i < data_.series.size(); ++i)
+      {
+         svg_.open("g");
+         for (auto b = size_t(0); b < buckets; ++b)
+         {
+            if (counts[i][b] == 0)
+               continue;
+            const auto top = y(static_cast<double>(counts[i][b]));
+            rect(x(edges.values[b]) + bucket_px * 0.05 + bar * static_cast<double>(i),
+               top, bar, y(c_ticks.min()) - top, data_.series[i].color);
+         }
+         svg_.close();
+      }
+   }
+
+   void renderer::render()
+   {
+      layout();
+      const auto& options = chart_.options;
+      rect(0.0, 0.0, chart_.width, chart_.height, "#ffffff");
+      if (!options.title.empty())
+      {
+         svg_.open("text")
+            .attr("x", px(static_cast<double>(chart_.width) / 2.0))
+            .attr("y", "28")
+            .attr("text-anchor", "middle")
+            .attr("font-size", "16")
+            .attr("font-weight", "bold")
+            .inline_text(escape_xml(options.title));
+      }
+
+      switch (chart_.type)
+      {
+      case visualization::line:      render_line_or_scatter(true); break;
+      case visualization::scatter:   render_line_or_scatter(false); break;
+      case visualization::bar:       render_bar(); break;
+      case visualization::histogram: render_histogram(); break;
+      default:
+         throw std::invalid_argument("invalid chart visualization type");
+      }
+      axis_titles();
+      legend();
+   }
+}
+
+void gb2gc::svgchart::write_svg(output_sink& sink, const data_set_view& view,
+   const format& fmt) const
+{
+   const auto data = extract(view, options);
+   html_writer svg(sink, fmt);
+   svg.open("svg")
+      .attr("xmlns", "http://www.w3.org/2000/svg")
+      .attr("width", std::to_string(width))
+      .attr("height", std::to_string(height))
+      .attr("viewBox", "0 0 " + std::to_string(width) + " " + std::to_string(height))
+      .attr("font-family", escape_xml(options.font_name.empty() ? "Arial" : options.font_name))
+      .attr("font-size", "12");
+   renderer(svg, *this, data).render();
+   svg.close_all();
+}
+
+void gb2gc::svgchart::write_svg(std::ostream& os, const data_set_view& view,
+   const format& fmt) const
+{
+   output_sink sink(os);
+   write_svg(sink, view, fmt);
+   sink.flush();
+}
+
+void gb2gc::svgchart::write_svg_file(const char* path, const data_set_view& view,
+   const format& fmt) const
+{
+   auto sink = output_sink::open(path);
+   write_svg(sink, view, fmt);
+   sink.flush();
+}
@@ -0,0 +1,46 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_SVG_CHART_H
+#define GB2GC_SVG_CHART_H
+
+#include <ostream>
+
+#include "chart.h"
+
+namespace gb2gc
+{
+   // Chart renderer laying out bar, line, scatter and histogram charts in C++
+   // and writing static SVG. Unlike googlechart the output needs neither
+   // JavaScript nor network access to display and may be embedded directly
+   // in Markdown and HTML reports. Takes the same options and data as
+   // googlechart, i.e. the first column holds the keys and each other column
+   // a series. Bar charts are drawn with horizontal bars like the Google
+   // Chart bar chart, hence with the value axis horizontal.
+   class svgchart
+   {
+   public:
+      googlechart_options options;
+      googlechart::visualization type = googlechart::visualization::histogram;
+      unsigned width = googlechart_dom_options::default_width;
+      unsigned height = googlechart_dom_options::default_height;
+
+      void write_svg(output_sink& sink, const data_set_view& view,
+         const format& fmt = format()) const;
+      void write_svg(std::ostream& os, const data_set_view& view,
+         const format& fmt = format()) const;
+
+      // Writes the chart to the file at the given path, or to standard output
+      // if the path is '-'
+      void write_svg_file(const char* path, const data_set_view& view,
+         const format& fmt = format()) const;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_SVG_CHART_H
@@ -0,0 +1,175 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "thread_pool.h"
+
+#include <exception>
+
+// Identifies the pool and worker index of the current thread, if any
+struct worker_id
+{
+   const gb2gc::thread_pool* pool;
+   std::size_t               index;
+};
+
+static thread_local worker_id current_worker = { nullptr, 0 };
+
+gb2gc::thread_pool::thread_pool(unsigned threads)
+   : next_(0)
+   , pending_(0)
+   , stop_(false)
+{
+   if (threads == 0)
+      threads = hardware_threads();
+   queues_.reserve(threads);
+   for (auto i = 0u; i < threads; ++i)
+      queues_.emplace_back(new queue());
+   workers_.reserve(threads);
+   for (auto i = 0u; i < threads; ++i)
+      workers_.emplace_back([this, i]() { work(i); });
+}
+
+gb2gc::thread_pool::~thread_pool() noexcept
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+   }
+   cv_.notify_all();
+   for (auto& worker : workers_)
+      worker.join();
+}
+
+unsigned gb2gc::thread_pool::size() const noexcept
+{
+   return static_cast<unsigned>(workers_.size());
+}
+
+unsigned gb2gc::thread_pool::hardware_threads() noexcept
+{
+   const auto n = std::thread::hardware_concurrency();
+   return n == 0 ? 1u : n;
+}
+
+std::size_t gb2gc::thread_pool::worker_index() const noexcept
+{
+   return current_worker.pool == this ? current_worker.index : queues_.size();
+}
+
+void gb2gc::thread_pool::submit(task t)
+{
+   // Count the task before it is queued so that pending_ never falls below
+   // the number of queued tasks, a worker seeing a task counted but not yet
+   // queued simply retries
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++pending_;
+   }
+
+   auto index = worker_index();
+   if (index == queues_.size())
+      index = next_++ % queues_.size();
+   {
+      auto& q = *queues_[index];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.tasks.emplace_back(std::move(t));
+   }
+   cv_.notify_one();
+}
+
+bool gb2gc::thread_pool::run_one(std::size_t index)
+{
+   task t;
+   const auto n = queues_.size();
+   if (index < n)
+   {
+      // Own queue is used as a stack to process the most recently submitted,
+      // i.e. typically nested and cache-warm, tasks first
+      auto& q = *queues_[index];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks.empty())
+      {
+         t = std::move(q.tasks.back());
+         q.tasks.pop_back();
+         --pending_;
+      }
+   }
+   for (auto i = std::size_t(1); !t && i <= n; ++i)
+   {
+      // Steal the oldest task of another queue
+      auto& q = *queues_[(index + i) % n];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.tasks.empty())
+      {
+         t = std::move(q.tasks.front());
+         q.tasks.pop_front();
+         --pending_;
+      }
+   }
+   if (!t)
+      return false;
+   t();
+   return true;
+}
+
+void gb2gc::thread_pool::parallel_for(std::size_t n,
+   const std::function<void(std::size_t)>& fn)
+{
+   std::mutex mutex;
+   std::condition_variable done;
+   std::size_t remaining = n;
+   std::exception_ptr error;
+
+   for (auto i = std::size_t(0); i < n; ++i)
+   {
+      submit([&, i]()
+      {
+         std::exception_ptr e;
+         try
+         {
+            fn(i);
+         }
+         catch (...)
+         {
+            e = std::current_exception();
+         }
+
+         std::lock_guard<std::mutex> lock(mutex);
+         if (e && !error)
+            error = e;
+         if (--remaining == 0)
+            done.notify_one();
+      });
+   }
+
+   // Help executing queued tasks until there is nothing left to run, then
+   // wait for invocations still executing on other threads
+   const auto index = worker_index();
+   std::unique_lock<std::mutex> lock(mutex);
+   while (remaining != 0)
+   {
+      lock.unlock();
+      const auto ran = run_one(index);
+      lock.lock();
+      if (!ran)
+         done.wait(lock, [&]() { return remaining == 0; });
+   }
+   if (error)
+      std::rethrow_exception(error);
+}
+
+void gb2gc::thread_pool::work(std::size_t index)
+{
+   current_worker = worker_id{ this, index };
+   for (;;)
+   {
+      if (run_one(index))
+         continue;
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stop_ || pending_ != 0; });
+      if (stop_ && pending_ == 0)
+         return; // stopped and drained
+   }
+}
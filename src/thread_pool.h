@@ -0,0 +1,83 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_THREAD_POOL_H
+#define GB2GC_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gb2gc
+{
+   // Fixed size pool of work-stealing worker threads. Each worker has its own
+   // task queue. Tasks submitted by a worker are pushed to and executed from
+   // the back of its own queue, while idle workers steal from the front of the
+   // queues of other workers. Tasks submitted by other threads are distributed
+   // over the worker queues.
+   class thread_pool final
+   {
+   public:
+      using task = std::function<void()>;
+
+      // Creates a pool with the given number of worker threads. Zero selects
+      // the number of hardware threads.
+      explicit thread_pool(unsigned threads = 0);
+      ~thread_pool() noexcept;
+      thread_pool(const thread_pool&) = delete;
+      thread_pool& operator=(const thread_pool&) = delete;
+
+      unsigned size() const noexcept;
+
+      void submit(task t);
+
+      // Invokes fn(i) for each i in [0, n) on the pool and blocks until all
+      // invocations have completed. If any invocation throws, the first
+      // exception is rethrown on the calling thread. The calling thread
+      // executes queued tasks while waiting which allows parallel_for to be
+      // nested within tasks of the same pool.
+      void parallel_for(std::size_t n, const std::function<void(std::size_t)>& fn);
+
+      // Returns the number of hardware threads, at least one
+      static unsigned hardware_threads() noexcept;
+
+   private:
+      struct queue
+      {
+         std::mutex       mutex;
+         std::deque<task> tasks;
+      };
+
+      void work(std::size_t index);
+
+      // Executes a single queued task, if any, on behalf of the worker with
+      // the given index or size() if not called by a worker of this pool.
+      // Returns true if a task was executed.
+      bool run_one(std::size_t index);
+
+      // Returns the index of the calling worker or size() if not a worker
+      std::size_t worker_index() const noexcept;
+
+      std::vector<std::unique_ptr<queue>> queues_;
+      std::vector<std::thread> workers_;
+      std::atomic<std::size_t> next_;    // queue receiving next external task
+      std::atomic<std::size_t> pending_; // number of queued tasks
+      std::mutex               mutex_;
+      std::condition_variable  cv_;
+      bool                     stop_;
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_THREAD_POOL_H
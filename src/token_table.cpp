@@ -0,0 +1,111 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include "token_table.h"
+
+#include <cstring>
+#include <stdexcept>
+
+gb2gc::token_id gb2gc::token_table::intern(const char* data, std::size_t size)
+{
+   return strings_.intern(data, size);
+}
+
+gb2gc::token_id gb2gc::token_table::intern(const std::string& token)
+{
+   return strings_.intern(token);
+}
+
+gb2gc::token_id gb2gc::token_table::find(const char* data, std::size_t size) const noexcept
+{
+   return strings_.find(data, size);
+}
+
+gb2gc::token_id gb2gc::token_table::find(const std::string& token) const noexcept
+{
+   return strings_.find(token);
+}
+
+std::string gb2gc::token_table::str(token_id id) const
+{
+   return strings_.str(id);
+}
+
+const gb2gc::string_pool& gb2gc::token_table::strings() const noexcept
+{
+   return strings_;
+}
+
+double gb2gc::token_table::number(token_id id) const
+{
+   if (numbers_.size() < strings_.count())
+   {
+      numbers_.resize(strings_.count());
+      parsed_.resize(strings_.count(), false);
+   }
+   if (!parsed_.at(id))
+   {
+      numbers_[id] = std::stod(strings_.str(id));
+      parsed_[id] = true;
+   }
+   return numbers_[id];
+}
+
+std::size_t gb2gc::token_table::size() const noexcept
+{
+   return strings_.count();
+}
+
+void gb2gc::tokenized_names::add(const std::string& name)
+{
+   add(name.data(), name.size());
+}
+
+void gb2gc::tokenized_names::add(const char* data, std::size_t size)
+{
+   // Same tokens as split(name, '/'), i.e. a trailing delimiter do not
+   // result in an empty token
+   const auto end = data + size;
+   auto first = data;
+   while (first < end)
+   {
+      auto last = static_cast<const char*>(std::memchr(first, '/',
+         static_cast<std::size_t>(end - first)));
+      if (last == nullptr)
+         last = end;
+      tokens_.emplace_back(table_.intern(first, static_cast<std::size_t>(last - first)));
+      first = last + 1;
+   }
+   offsets_.emplace_back(tokens_.size());
+}
+
+std::size_t gb2gc::tokenized_names::size() const noexcept
+{
+   return offsets_.size() - 1;
+}
+
+const gb2gc::token_id* gb2gc::tokenized_names::begin(std::size_t index) const noexcept
+{
+   return tokens_.data() + offsets_[index];
+}
+
+const gb2gc::token_id* gb2gc::tokenized_names::end(std::size_t index) const noexcept
+{
+   return tokens_.data() + offsets_[index + 1];
+}
+
+std::size_t gb2gc::tokenized_names::count(std::size_t index) const noexcept
+{
+   return offsets_[index + 1] - offsets_[index];
+}
+
+gb2gc::token_table& gb2gc::tokenized_names::table() noexcept
+{
+   return table_;
+}
+
+const gb2gc::token_table& gb2gc::tokenized_names::table() const noexcept
+{
+   return table_;
+}
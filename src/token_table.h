@@ -0,0 +1,90 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#ifdef _MSC_VER
+#pragma once    // Improves build time on MSVC
+#endif
+
+#ifndef GB2GC_TOKEN_TABLE_H
+#define GB2GC_TOKEN_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "string_pool.h"
+
+namespace gb2gc
+{
+   using token_id = string_pool::code_type;
+
+   // Id returned when looking up a token that has not been interned
+   static constexpr token_id no_token = string_pool::npos;
+
+   // Interns tokens, i.e. stores each distinct token once in a string pool
+   // and identifies it by a dense integer id, so that tokens may be compared
+   // by id instead of by content.
+   class token_table final
+   {
+   public:
+      token_table() = default;
+      token_table(const token_table&) = delete;
+      token_table& operator=(const token_table&) = delete;
+      token_table(token_table&&) = default;
+      token_table& operator=(token_table&&) = default;
+
+      // Returns the id of the given token, adding it to the table if needed
+      token_id intern(const char* data, std::size_t size);
+      token_id intern(const std::string& token);
+
+      // Returns the id of the given token or no_token if not in the table
+      token_id find(const char* data, std::size_t size) const noexcept;
+      token_id find(const std::string& token) const noexcept;
+
+      std::string str(token_id id) const;
+
+      const string_pool& strings() const noexcept;
+
+      // Returns the token interpreted as a number. The token is only parsed
+      // on first use. Throws std::invalid_argument if the token is not a
+      // number. Not thread-safe.
+      double number(token_id id) const;
+
+      std::size_t size() const noexcept;
+
+   private:
+      string_pool                 strings_;
+      mutable std::vector<double> numbers_;
+      mutable std::vector<bool>   parsed_;
+   };
+
+   // Benchmark names split on '/' into interned tokens. The tokens of all
+   // names are stored contiguously.
+   class tokenized_names final
+   {
+   public:
+      // Tokenizes the given name and appends it
+      void add(const std::string& name);
+      void add(const char* data, std::size_t size);
+
+      std::size_t size() const noexcept;
+
+      // Returns the tokens of the name at the given index
+      const token_id* begin(std::size_t index) const noexcept;
+      const token_id* end(std::size_t index) const noexcept;
+      std::size_t count(std::size_t index) const noexcept;
+
+      token_table& table() noexcept;
+      const token_table& table() const noexcept;
+
+   private:
+      token_table              table_;
+      std::vector<token_id>    tokens_;
+      std::vector<std::size_t> offsets_ = std::vector<std::size_t>(1, 0);
+   };
+
+} // namespace gb2gc
+
+#endif // GB2GC_TOKEN_TABLE_H
@@ -8,10 +8,13 @@
 #include <exception>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include <nonstd/variant.hpp>
 
+#include "number_format.h"
+
 namespace gb2gc {
 
 using null_type = nonstd::monostate;
@@ -33,25 +36,44 @@ using variant = nonstd::variant<
     long double,         // 11
     std::string>;        // 12
 
+// Writes the given numeric variant to the buffer starting at first, which
+// must hold at least max_number_chars characters, and returns a pointer past
+// the last written character. Nothing is written for non-numeric variants.
+inline char* format_number(char* first, gb2gc::variant const & v) noexcept
+{
+    switch (v.index())
+    {
+    case 1:  return format_number(first, static_cast<long long>(nonstd::get<1>(v)));
+    case 2:  return format_number(first, static_cast<unsigned long long>(nonstd::get<2>(v)));
+    case 3:  return format_number(first, static_cast<long long>(nonstd::get<3>(v)));
+    case 4:  return format_number(first, static_cast<unsigned long long>(nonstd::get<4>(v)));
+    case 5:  return format_number(first, static_cast<long long>(nonstd::get<5>(v)));
+    case 6:  return format_number(first, static_cast<unsigned long long>(nonstd::get<6>(v)));
+    case 7:  return format_number(first, nonstd::get<7>(v));
+    case 8:  return format_number(first, nonstd::get<8>(v));
+    case 9:  return format_number(first, nonstd::get<9>(v));
+    case 10: return format_number(first, nonstd::get<10>(v));
+    case 11: return format_number(first, nonstd::get<11>(v));
+    default: return first;
+    }
+}
+
 inline std::ostream& operator<<(std::ostream & os, gb2gc::variant const & v)
 {
     switch (v.index())
     {
-    case 0:  os << "'null'"; break;
-    case 1:  os << std::to_string(nonstd::get<1>(v)); break;
-    case 2:  os << std::to_string(nonstd::get<2>(v)); break;
-    case 3:  os << std::to_string(nonstd::get<3>(v)); break;
-    case 4:  os << std::to_string(nonstd::get<4>(v)); break;
-    case 5:  os << std::to_string(nonstd::get<5>(v)); break;
-    case 6:  os << std::to_string(nonstd::get<6>(v)); break;
-    case 7:  os << std::to_string(nonstd::get<7>(v)); break;
-    case 8:  os << std::to_string(nonstd::get<8>(v)); break;
-    case 9:  os << std::to_string(nonstd::get<9>(v)); break;
-    case 10: os << std::to_string(nonstd::get<10>(v)); break;
-    case 11: os << std::to_string(nonstd::get<11>(v)); break;
-    case 12: os << '\'' << nonstd::get<12>(v) << '\''; break;
+    case 0:
+        os << "'null'";
+        break;
+    case 12:
+        os << '\'' << nonstd::get<12>(v) << '\'';
+        break;
     default:
-        throw std::out_of_range("variant index out of range");
+        if (v.index() > 12)
+            throw std::out_of_range("variant index out of range");
+        char buffer[max_number_chars];
+        os.write(buffer, format_number(buffer, v) - buffer);
+        break;
     }
     return os;
 }
@@ -0,0 +1,69 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "aggregate.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_aggregate_test : public ::testing::Test
+{
+protected:
+   static double apply(const char* name, std::vector<double> values)
+   {
+      return aggregate(name)(values);
+   }
+};
+
+TEST_F(gb2gc_aggregate_test, constructor__should_throw__if_invalid_name)
+{
+   EXPECT_THROW(aggregate("average"), std::invalid_argument);
+   EXPECT_THROW(aggregate("p"), std::invalid_argument);
+   EXPECT_THROW(aggregate("p9x"), std::invalid_argument);
+   EXPECT_THROW(aggregate("p-1"), std::invalid_argument);
+   EXPECT_THROW(aggregate("p100.5"), std::invalid_argument);
+}
+
+TEST_F(gb2gc_aggregate_test, function_operator__should_return_first_value__if_default_constructed)
+{
+   std::vector<double> values({ 3.0, 1.0 });
+   EXPECT_EQ(aggregate()(values), 3.0);
+}
+
+TEST_F(gb2gc_aggregate_test, function_operator__should_compute_statistic__if_valid_name)
+{
+   const std::vector<double> values({ 4.0, 1.0, 3.0, 2.0 });
+   EXPECT_DOUBLE_EQ(apply("mean", values), 2.5);
+   EXPECT_DOUBLE_EQ(apply("median", values), 2.5);
+   EXPECT_DOUBLE_EQ(apply("min", values), 1.0);
+   EXPECT_DOUBLE_EQ(apply("max", values), 4.0);
+   EXPECT_DOUBLE_EQ(apply("stddev", values), std::sqrt(5.0 / 3.0));
+   EXPECT_DOUBLE_EQ(apply("cv", values), std::sqrt(5.0 / 3.0) / 2.5);
+}
+
+TEST_F(gb2gc_aggregate_test, function_operator__should_interpolate_percentile__if_between_values)
+{
+   const std::vector<double> values({ 10.0, 40.0, 20.0, 30.0, 50.0 });
+   EXPECT_DOUBLE_EQ(apply("p0", values), 10.0);
+   EXPECT_DOUBLE_EQ(apply("p90", values), 46.0);
+   EXPECT_DOUBLE_EQ(apply("p100", values), 50.0);
+   EXPECT_DOUBLE_EQ(apply("p37.5", values), 25.0);
+}
+
+TEST_F(gb2gc_aggregate_test, function_operator__should_return_zero_deviation__if_single_value)
+{
+   EXPECT_DOUBLE_EQ(apply("stddev", { 7.0 }), 0.0);
+   EXPECT_DOUBLE_EQ(apply("cv", { 7.0 }), 0.0);
+   EXPECT_DOUBLE_EQ(apply("median", { 7.0 }), 7.0);
+}
+
+TEST_F(gb2gc_aggregate_test, function_operator__should_throw__if_no_values)
+{
+   std::vector<double> values;
+   EXPECT_THROW(aggregate("mean")(values), std::invalid_argument);
+}
@@ -0,0 +1,77 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "benchmark_table.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_benchmark_table_test : public ::testing::Test
+{
+public:
+   gb2gc_benchmark_table_test()
+      : first(nlohmann::json::parse(R"([
+           { "name": "BM_A/1", "real_time": 1.5, "error_occurred": true, "label": null },
+           { "name": "BM_A/2", "real_time": 2 } ])"))
+      , second(nlohmann::json::parse(R"([
+           { "name": "BM_B/1", "cpu_time": 3 } ])"))
+   { }
+
+   static std::string str(const field_value& value)
+   {
+      return std::string(value.data, value.size);
+   }
+
+   nlohmann::json first;
+   nlohmann::json second;
+};
+
+TEST_F(gb2gc_benchmark_table_test, json_benchmark_table__should_read_typed_values__if_field_present)
+{
+   json_benchmark_table table(first);
+   ASSERT_EQ(table.size(), 2u);
+
+   const auto name = table.field("name");
+   EXPECT_EQ(table.field("name"), name);
+   EXPECT_EQ(table.value(name, 1).type, field_value::kind::string);
+   EXPECT_EQ(str(table.value(name, 1)), "BM_A/2");
+
+   const auto real_time = table.field("real_time");
+   EXPECT_EQ(table.value(real_time, 0).type, field_value::kind::number);
+   EXPECT_EQ(table.value(real_time, 0).number, 1.5);
+
+   const auto error = table.field("error_occurred");
+   EXPECT_EQ(table.value(error, 0).type, field_value::kind::boolean);
+   EXPECT_EQ(table.value(error, 0).number, 1.0);
+}
+
+TEST_F(gb2gc_benchmark_table_test, json_benchmark_table__should_read_missing__if_field_absent_or_null)
+{
+   json_benchmark_table table(first);
+   EXPECT_EQ(table.value(table.field("error_occurred"), 1).type, field_value::kind::missing);
+   EXPECT_EQ(table.value(table.field("label"), 0).type, field_value::kind::missing);
+}
+
+TEST_F(gb2gc_benchmark_table_test, merged_benchmark_table__should_concatenate_in_order_and_tag_input_file__if_multiple_tables)
+{
+   json_benchmark_table a(first);
+   json_benchmark_table b(second);
+   merged_benchmark_table table({ &a, &b }, { "a.json", "b.json" });
+   ASSERT_EQ(table.size(), 3u);
+
+   const auto name = table.field("name");
+   EXPECT_EQ(str(table.value(name, 0)), "BM_A/1");
+   EXPECT_EQ(str(table.value(name, 2)), "BM_B/1");
+
+   const auto input_file = table.field("input_file");
+   EXPECT_EQ(str(table.value(input_file, 1)), "a.json");
+   EXPECT_EQ(str(table.value(input_file, 2)), "b.json");
+
+   const auto cpu_time = table.field("cpu_time");
+   EXPECT_EQ(table.value(cpu_time, 0).type, field_value::kind::missing);
+   EXPECT_EQ(table.value(cpu_time, 2).number, 3.0);
+}
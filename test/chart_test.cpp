@@ -75,11 +75,7 @@ TEST_F(gb2gc_chart_test, write_html_file__should_create_bar_chart_html_document_
         ds.add_row(x, 1.0 + x * 2.0, 2.0 + x * 2.0);
     }
 
-    auto x = to_string(gb2gc::variant(1.0));
-    const auto len = x.length();
-    ASSERT_GE(len, 2u);
-    auto precision = len - 2;
-    ASSERT_EQ(precision, 6u);
+    ASSERT_EQ(to_string(gb2gc::variant(1.0)), "1");
 
     googlechart gc;
     gc.type = googlechart::visualization::bar;
@@ -106,11 +102,7 @@ TEST_F(gb2gc_chart_test, write_html_file__should_create_histogram_chart_html_doc
         ds.add_row(x, 1.0 + x * 2.0);
     }
 
-    auto x = to_string(gb2gc::variant(1.0));
-    const auto len = x.length();
-    ASSERT_GE(len, 2u);
-    auto precision = len - 2;
-    ASSERT_EQ(precision, 6u);
+    ASSERT_EQ(to_string(gb2gc::variant(1.0)), "1");
 
     googlechart gc;
     gc.type = googlechart::visualization::histogram;
@@ -159,4 +151,141 @@ TEST_F(gb2gc_chart_test, write_axis__should_write_range_limites__if_min_max_is_s
     axis.max_value = 15;
     gb2gc::detail::write_axis(ss, fmt, 0, axis);
     EXPECT_STREQ(ss.str().c_str(), "{ minValue: -5, maxValue: 15 }");
-}
\ No newline at end of file
+}
+TEST_F(gb2gc_chart_test, write_options__should_write_named_variable__if_writing_to_stream)
+{
+    std::stringstream ss;
+    gb2gc::format fmt;
+
+    gb2gc::googlechart_options opt;
+    opt.title = "xyz";
+    gb2gc::detail::write_options(ss, fmt, 0, opt, "opt");
+    EXPECT_EQ(0u, ss.str().find("var opt = {"));
+    EXPECT_NE(std::string::npos, ss.str().find("title: 'xyz',"));
+}
+
+TEST_F(gb2gc_chart_test, write_data_set__should_escape_strings__if_containing_quotes)
+{
+    std::stringstream ss;
+    gb2gc::format fmt;
+
+    data_set ds({ "it's" });
+    ds.add_row(std::string("a'b"));
+    ds.add_row(std::string("</script>"));
+    ds.add_row(std::string("a'b"));
+    gb2gc::detail::write_data_set(ss, fmt, 0, ds);
+    EXPECT_EQ(ss.str(),
+        "var data = new google.visualization.DataTable({\n"
+        "  cols: [{label:'it\\'s',type:'string'}],\n"
+        "  rows: [\n"
+        "    {c:[{v:'a\\'b'}]},\n"
+        "    {c:[{v:'<\\/script>'}]},\n"
+        "    {c:[{v:'a\\'b'}]}\n"
+        "  ]\n"
+        "});\n");
+}
+
+TEST_F(gb2gc_chart_test, write_data_set__should_write_projected_rows__if_view)
+{
+    std::stringstream ss;
+    gb2gc::format fmt;
+
+    data_set ds({ "X", "Y", "Z" });
+    ds.add_row(1, std::string("a"), 1.5);
+    ds.add_row(2, std::string("b"), 2.5);
+    ds.add_row(3, std::string("c"), 3.5);
+    const auto view = data_set_view(ds).select({ 0, 1 }).filter({ 2, 0 });
+    gb2gc::detail::write_data_set(ss, fmt, 0, view);
+    EXPECT_EQ(ss.str(),
+        "var data = new google.visualization.DataTable({\n"
+        "  cols: [{label:'X',type:'number'}, {label:'Y',type:'string'}],\n"
+        "  rows: [\n"
+        "    {c:[{v:3},{v:'c'}]},\n"
+        "    {c:[{v:1},{v:'a'}]}\n"
+        "  ]\n"
+        "});\n");
+}
+
+TEST_F(gb2gc_chart_test, write_data_set__should_write_dense_literal__if_compact_format)
+{
+    std::stringstream ss;
+    const auto fmt = gb2gc::format::minified();
+
+    data_set ds({ "X", "Y" });
+    ds.add_row(1, 1.5);
+    ds.add_row(2, 2.5);
+    gb2gc::detail::write_data_set(ss, fmt, 2, ds);
+    EXPECT_EQ(ss.str(),
+        "var data = new google.visualization.DataTable({"
+        "cols:[{label:'X',type:'number'},{label:'Y',type:'number'}],"
+        "rows:[{c:[{v:1},{v:1.5}]},{c:[{v:2},{v:2.5}]}]"
+        "});");
+}
+
+TEST_F(gb2gc_chart_test, write_html__should_omit_indentation_comments_and_line_breaks__if_compact)
+{
+    data_set ds({ "X", "Y" });
+    ds.add_row(1, 2);
+
+    googlechart gc;
+    gc.type = googlechart::visualization::line;
+    googlechart_dom_options dom_options;
+    dom_options.compact = true;
+    std::stringstream ss;
+    gc.write_html(ss, ds, dom_options);
+
+    const auto html = ss.str();
+    EXPECT_EQ(html.find('\n'), std::string::npos);
+    EXPECT_EQ(html.find("<!--"), std::string::npos);
+    EXPECT_EQ(html.find("  "), std::string::npos);
+    EXPECT_EQ(html.substr(0, 12), "<html><head>");
+    EXPECT_NE(html.find("rows:[{c:[{v:1},{v:2}]}]"), std::string::npos);
+}
+
+TEST_F(gb2gc_chart_test, write_data_set__should_write_typed_columns_and_null_cells__if_mixed_or_missing_values)
+{
+    std::stringstream ss;
+    gb2gc::format fmt;
+
+    data_set ds({ "X", "Y", "Z" });
+    ds.add_row(1, 1.5, 2);
+    ds.add_row(2, null_type{}, std::string("b"));
+    gb2gc::detail::write_data_set(ss, fmt, 0, ds);
+    EXPECT_EQ(ss.str(),
+        "var data = new google.visualization.DataTable({\n"
+        "  cols: [{label:'X',type:'number'}, {label:'Y',type:'number'}, {label:'Z',type:'string'}],\n"
+        "  rows: [\n"
+        "    {c:[{v:1},{v:1.5},{v:'2'}]},\n"
+        "    {c:[{v:2},null,{v:'b'}]}\n"
+        "  ]\n"
+        "});\n");
+}
+
+TEST_F(gb2gc_chart_test, write__should_share_data_table_between_chart_views__if_dashboard)
+{
+    data_set ds({ "X", "A", "B" });
+    ds.add_row(1, 10, null_type{});
+    ds.add_row(2, 20, 30);
+
+    googlechart_dashboard dashboard;
+    googlechart_dashboard::chart first;
+    first.gc.type = googlechart::visualization::line;
+    first.dom_options.div = "a_div";
+    first.columns = { 0, 1 };
+    googlechart_dashboard::chart second;
+    second.gc.type = googlechart::visualization::bar;
+    second.dom_options.div = "b_div";
+    second.columns = { 0, 2 };
+    second.rows = { 1 };
+    dashboard.charts.emplace_back(std::move(first));
+    dashboard.charts.emplace_back(std::move(second));
+
+    output_sink sink;
+    write(sink, gb2gc::format::minified(), 0, dashboard, data_set_view(ds));
+    const auto js = sink.str();
+    EXPECT_EQ(js.find("DataTable("), js.rfind("DataTable("));
+    EXPECT_NE(js.find("var view0 = new google.visualization.DataView(data);view0.setColumns([0,1]);var options0 = {"), std::string::npos);
+    EXPECT_NE(js.find("new google.visualization.LineChart(document.getElementById('a_div')).draw(view0, options0);"), std::string::npos);
+    EXPECT_NE(js.find("view1.setColumns([0,2]);view1.setRows([1]);"), std::string::npos);
+    EXPECT_NE(js.find("new google.visualization.BarChart(document.getElementById('b_div')).draw(view1, options1);"), std::string::npos);
+}
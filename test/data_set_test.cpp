@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include "data_set.h"
 
+#include <algorithm>
 #include <vector>
 #include <array>
 #include <unordered_map>
@@ -61,3 +62,167 @@ TEST_F(gb2gc_data_set_test, usage__replace_with_better_tests)
    EXPECT_TRUE(it == ds.row_end());
 }
 
+
+TEST_F(gb2gc_data_set_test, set__should_use_typed_storage__if_single_type_per_column)
+{
+   data_set ds({ "I", "D", "S", "N" });
+   ds.add_row(1, 1.5, std::string("a"), null_value());
+   ds.add_row(2, 2.5, std::string("a"), null_value());
+
+   EXPECT_EQ(ds.get_col(0).storage_type(), data_set::column_type::storage::integer);
+   EXPECT_EQ(ds.get_col(1).storage_type(), data_set::column_type::storage::floating);
+   EXPECT_EQ(ds.get_col(2).storage_type(), data_set::column_type::storage::string);
+   EXPECT_EQ(ds.get_col(3).storage_type(), data_set::column_type::storage::none);
+
+   EXPECT_EQ(ds.get_col(0)[1], variant(2));
+   EXPECT_EQ(ds.get_col(1)[1], variant(2.5));
+   EXPECT_EQ(ds.get_col(2)[1], variant(std::string("a")));
+   EXPECT_TRUE(ds.get_col(3).is_null(1));
+}
+
+TEST_F(gb2gc_data_set_test, set__should_preserve_variant_alternative__if_stored_typed)
+{
+   data_set ds({ "A", "B", "C" });
+   ds.add_row(static_cast<unsigned short>(7), 1.5f, 123456789012345ull);
+
+   EXPECT_EQ(ds.get_col(0)[0].index(), variant(static_cast<unsigned short>(7)).index());
+   EXPECT_EQ(ds.get_col(1)[0], variant(1.5f));
+   EXPECT_EQ(ds.get_col(2)[0], variant(123456789012345ull));
+}
+
+TEST_F(gb2gc_data_set_test, set__should_track_nulls__if_cells_not_assigned)
+{
+   data_set ds({ "X", "Y" });
+   ds.resize_rows(3);
+   ds.get_col(1)[1] = variant(3.0);
+
+   EXPECT_TRUE(ds.get_col(1).is_null(0));
+   EXPECT_FALSE(ds.get_col(1).is_null(1));
+   EXPECT_TRUE(ds.get_col(1).is_null(2));
+   EXPECT_EQ(ds.get_col(1)[0], variant());
+   EXPECT_EQ(ds.get_col(1)[1], variant(3.0));
+
+   ds.get_col(1)[1] = null_value();
+   EXPECT_TRUE(ds.get_col(1).is_null(1));
+}
+
+TEST_F(gb2gc_data_set_test, set__should_fall_back_to_variants__if_mixed_types_in_column)
+{
+   data_set ds({ "X" });
+   ds.add_row(1.0);
+   ds.add_row(std::string("two"));
+   ds.add_row(3);
+
+   EXPECT_EQ(ds.get_col(0).storage_type(), data_set::column_type::storage::mixed);
+   EXPECT_EQ(ds.get_col(0)[0], variant(1.0));
+   EXPECT_EQ(ds.get_col(0)[1], variant(std::string("two")));
+   EXPECT_EQ(ds.get_col(0)[2], variant(3));
+}
+
+TEST_F(gb2gc_data_set_test, row_iterator__should_write_cell__if_assigned_through_row)
+{
+   data_set ds({ "X", "Y" });
+   ds.resize_rows(1);
+   auto it = ds.row_begin();
+   it[1] = variant(4.0);
+   *ds.row_begin(0) = variant(2.0);
+
+   EXPECT_EQ(ds.get_col(0)[0], variant(2.0));
+   EXPECT_EQ(it[1].get<double>(), 4.0);
+}
+
+TEST_F(gb2gc_data_set_test, set__should_share_string_codes__if_same_string_in_different_columns)
+{
+   data_set ds({ "X", "Y" });
+   ds.add_row(std::string("a"), std::string("b"));
+   ds.add_row(std::string("b"), std::string("a"));
+
+   EXPECT_EQ(&ds.get_col(0).strings(), &ds.get_col(1).strings());
+   EXPECT_EQ(ds.get_col(0).code(0), ds.get_col(1).code(1));
+   EXPECT_EQ(ds.get_col(0).code(1), ds.get_col(1).code(0));
+   EXPECT_EQ(ds.strings().count(), 2u);
+}
+
+TEST_F(gb2gc_data_set_test, sort__should_order_rows_numerically__if_integer_key)
+{
+   data_set ds({ "X", "Y" });
+   ds.add_row(10, std::string("ten"));
+   ds.add_row(2, std::string("two"));
+   ds.add_row(variant(), std::string("null"));
+   ds.add_row(-1, std::string("minus one"));
+   ds.sort(0);
+
+   EXPECT_EQ(ds.get_col(0)[0], variant());
+   EXPECT_EQ(ds.get_col(0)[1], variant(-1));
+   EXPECT_EQ(ds.get_col(0)[2], variant(2));
+   EXPECT_EQ(ds.get_col(0)[3], variant(10));
+   EXPECT_EQ(ds.get_col(1)[0], variant(std::string("null")));
+   EXPECT_EQ(ds.get_col(1)[3], variant(std::string("ten")));
+}
+
+TEST_F(gb2gc_data_set_test, sort__should_order_by_subsequent_keys__if_first_keys_equal)
+{
+   data_set ds({ "X", "Y", "Z" });
+   ds.add_row(std::string("b"), 1.0, 0);
+   ds.add_row(std::string("a"), 2.0, 1);
+   ds.add_row(std::string("b"), 3.0, 2);
+   ds.add_row(std::string("a"), 2.0, 3);
+   ds.sort({ { 0, false }, { 1, true } });
+
+   EXPECT_EQ(ds.get_col(2)[0], variant(1));
+   EXPECT_EQ(ds.get_col(2)[1], variant(3)); // stable for equal keys
+   EXPECT_EQ(ds.get_col(2)[2], variant(2));
+   EXPECT_EQ(ds.get_col(2)[3], variant(0));
+}
+
+TEST_F(gb2gc_data_set_test, sort__should_order_numbers_before_strings__if_mixed_column)
+{
+   data_set ds({ "X" });
+   ds.add_row(std::string("a"));
+   ds.add_row(2.5);
+   ds.add_row(2);
+   ds.sort(0);
+
+   EXPECT_EQ(ds.get_col(0)[0], variant(2));
+   EXPECT_EQ(ds.get_col(0)[1], variant(2.5));
+   EXPECT_EQ(ds.get_col(0)[2], variant(std::string("a")));
+}
+
+TEST_F(gb2gc_data_set_test, sort_index__should_match_sequential_sort__if_large_table)
+{
+   const auto rows = 200000;
+   data_set ds({ "X" });
+   ds.reserve_rows(rows);
+   std::vector<long long> expected;
+   for (auto i = 0; i < rows; ++i)
+   {
+      const auto value = static_cast<long long>((i * 7919) % 1000);
+      ds.add_row(value);
+      expected.emplace_back(value);
+   }
+   std::sort(expected.begin(), expected.end());
+
+   const auto index = ds.sort_index({ { 0, false } });
+   ASSERT_EQ(index.size(), static_cast<size_t>(rows));
+   for (auto i = 1u; i < index.size(); ++i)
+   {
+      ASSERT_EQ(ds.get_col(0)[index[i]], variant(expected[i]));
+      if (expected[i - 1] == expected[i])
+      {
+         ASSERT_LT(index[i - 1], index[i]);
+      }
+   }
+}
+
+TEST_F(gb2gc_data_set_test, to_number__should_convert_numeric_alternatives__if_variant_holds_number)
+{
+   double value = 0.0;
+   EXPECT_TRUE(to_number(variant(static_cast<unsigned short>(7)), value));
+   EXPECT_EQ(value, 7.0);
+   EXPECT_TRUE(to_number(variant(18446744073709551615ull), value));
+   EXPECT_EQ(value, 18446744073709551615.0);
+   EXPECT_TRUE(to_number(variant(1.5L), value));
+   EXPECT_EQ(value, 1.5);
+   EXPECT_FALSE(to_number(variant(std::string("1")), value));
+   EXPECT_FALSE(to_number(variant(null_value()), value));
+}
@@ -0,0 +1,75 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "data_set_view.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_data_set_view_test : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      auto ds = std::make_shared<data_set>(data_set({ "X", "Y", "Z" }));
+      for (auto i = 0; i < 5; ++i)
+         ds->add_row(i, 10.0 * i, std::string(1, static_cast<char>('a' + i)));
+      data = ds;
+   }
+
+   std::shared_ptr<const data_set> data;
+};
+
+TEST_F(gb2gc_data_set_view_test, constructor__should_view_all_columns_and_rows__if_constructed_from_data_set)
+{
+   data_set_view view(data);
+   EXPECT_EQ(view.cols(), 3u);
+   EXPECT_EQ(view.rows(), 5u);
+   EXPECT_EQ(&view.data(), data.get());
+   EXPECT_EQ(view.value(1, 2), variant(20.0));
+}
+
+TEST_F(gb2gc_data_set_view_test, select__should_project_columns__if_valid_indices)
+{
+   const auto view = data_set_view(data).select({ 2, 0 });
+   ASSERT_EQ(view.cols(), 2u);
+   EXPECT_EQ(view.get_col(0).name(), "Z");
+   EXPECT_EQ(view.get_col(1).name(), "X");
+   EXPECT_EQ(view.select({ 1 }).get_col(0).name(), "X");
+   EXPECT_THROW(view.select({ 2 }), std::out_of_range);
+}
+
+TEST_F(gb2gc_data_set_view_test, slice__should_offset_rows__if_within_view)
+{
+   const auto view = data_set_view(data).slice(1, 3).slice(1, 2);
+   ASSERT_EQ(view.rows(), 2u);
+   EXPECT_EQ(view.row_index(0), 2u);
+   EXPECT_EQ(view.value(0, 1), variant(3));
+   EXPECT_THROW(view.slice(1, 2), std::out_of_range);
+}
+
+TEST_F(gb2gc_data_set_view_test, filter__should_compose_row_indices__if_derived_from_filtered_view)
+{
+   const auto filtered = data_set_view(data).filter({ 4, 0, 3 });
+   ASSERT_EQ(filtered.rows(), 3u);
+   EXPECT_EQ(filtered.value(0, 0), variant(4));
+
+   const auto view = filtered.slice(1, 2).filter({ 1 });
+   ASSERT_EQ(view.rows(), 1u);
+   EXPECT_EQ(view.row_index(0), 3u);
+   EXPECT_THROW(filtered.filter({ 3 }), std::out_of_range);
+}
+
+TEST_F(gb2gc_data_set_view_test, where__should_keep_matching_rows__if_predicate_given)
+{
+   const auto view = data_set_view(data).where([](const data_set_view& v, size_t row) {
+      return v.value(1, row).get<double>() >= 25.0;
+   });
+   ASSERT_EQ(view.rows(), 2u);
+   EXPECT_EQ(view.value(2, 0), variant(std::string("d")));
+   EXPECT_EQ(view.value(2, 1), variant(std::string("e")));
+}
@@ -0,0 +1,93 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "downsample.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_downsample_test : public ::testing::Test
+{
+protected:
+   void given_series(std::size_t n)
+   {
+      x.resize(n);
+      y.resize(n);
+      for (auto i = std::size_t(0); i < n; ++i)
+      {
+         x[i] = static_cast<double>(i);
+         y[i] = std::sin(static_cast<double>(i) * 0.01);
+      }
+   }
+
+   std::vector<double> x;
+   std::vector<double> y;
+};
+
+TEST_F(gb2gc_downsample_test, lttb__should_return_all_indices__if_threshold_not_less_than_size)
+{
+   given_series(5);
+   EXPECT_EQ(lttb(x.data(), y.data(), 5, 5), std::vector<std::size_t>({ 0, 1, 2, 3, 4 }));
+   EXPECT_EQ(lttb(x.data(), y.data(), 5, 2), std::vector<std::size_t>({ 0, 1, 2, 3, 4 }));
+}
+
+TEST_F(gb2gc_downsample_test, lttb__should_keep_first_and_last_points__if_downsampled)
+{
+   given_series(10000);
+   const auto selected = lttb(x.data(), y.data(), x.size(), 100);
+   ASSERT_EQ(selected.size(), 100u);
+   EXPECT_EQ(selected.front(), 0u);
+   EXPECT_EQ(selected.back(), 9999u);
+   for (auto i = std::size_t(1); i < selected.size(); ++i)
+      EXPECT_LT(selected[i - 1], selected[i]);
+}
+
+TEST_F(gb2gc_downsample_test, lttb__should_select_spike__if_single_outlier)
+{
+   given_series(1000);
+   for (auto& v : y)
+      v = 0.0;
+   y[517] = 100.0;
+   const auto selected = lttb(x.data(), y.data(), x.size(), 10);
+   EXPECT_NE(std::find(selected.begin(), selected.end(), 517u), selected.end());
+}
+
+TEST_F(gb2gc_downsample_test, downsample__should_return_view__if_max_points_is_zero)
+{
+   data_set ds({ "X", "Y" });
+   for (auto i = 0; i < 10; ++i)
+      ds.add_row(i, i * 2);
+   EXPECT_EQ(downsample(data_set_view(ds), 0).rows(), 10u);
+   EXPECT_EQ(downsample(data_set_view(ds), 10).rows(), 10u);
+}
+
+TEST_F(gb2gc_downsample_test, downsample__should_keep_rows_selected_by_any_series__if_multiple_series)
+{
+   data_set ds({ "X", "A", "B" });
+   for (auto i = 0; i < 100; ++i)
+      ds.add_row(i, i == 20 ? 50 : 0, i == 70 ? 50 : 0);
+   const auto view = downsample(data_set_view(ds), 3);
+   ASSERT_EQ(view.rows(), 4u);
+   EXPECT_EQ(view.value(0, 0), variant(0));
+   EXPECT_EQ(view.value(0, 1), variant(20));
+   EXPECT_EQ(view.value(0, 2), variant(70));
+   EXPECT_EQ(view.value(0, 3), variant(99));
+   EXPECT_EQ(view.value(2, 2), variant(50));
+}
+
+TEST_F(gb2gc_downsample_test, downsample__should_use_row_position__if_key_is_string)
+{
+   data_set ds({ "X", "Y" });
+   for (auto i = 0; i < 100; ++i)
+      ds.add_row(std::to_string(i), i == 40 ? 1.0 : 0.0);
+   const auto view = downsample(data_set_view(ds), 3);
+   ASSERT_EQ(view.rows(), 3u);
+   EXPECT_EQ(view.value(0, 1), variant(std::string("40")));
+}
@@ -0,0 +1,78 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "extractor.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_extractor_test : public ::testing::Test
+{
+public:
+   void SetUp()
+   {
+      benchmarks = nlohmann::json::parse(R"([
+         { "name": "BM_memcpy/8/64", "real_time": 1.5, "label": "BM_fast", "ok": true },
+         { "name": "BM_memcpy/16/64", "real_time": 2.5, "label": "slow", "ok": false } ])");
+      for (const auto& bm : benchmarks)
+         names.add(bm["name"].get<std::string>());
+   }
+
+   nlohmann::json  benchmarks;
+   tokenized_names names;
+};
+
+TEST_F(gb2gc_extractor_test, extract__should_extract_typed_columns__if_valid_selectors)
+{
+   const std::vector<selector> selectors({ 
+      selector("name/1"), selector("name"), selector("real_time"), selector("label"), selector("ok") });
+   const auto columns = column_extractor(selectors).extract(benchmarks, names, { 1, 0 });
+
+   ASSERT_EQ(columns.size(), 5u);
+   for (const auto& c : columns)
+      EXPECT_EQ(c.size(), 2u);
+
+   EXPECT_EQ(columns[0].cells[0], extracted_column::cell::number);
+   EXPECT_EQ(columns[0].numbers[0], 16.0);
+   EXPECT_EQ(columns[0].numbers[1], 8.0);
+   EXPECT_EQ(columns[1].cells[0], extracted_column::cell::token);
+   EXPECT_EQ(names.table().str(columns[1].tokens[0]), "memcpy/16/64");
+   EXPECT_EQ(columns[2].numbers[0], 2.5);
+   EXPECT_EQ(columns[2].numbers[1], 1.5);
+   EXPECT_EQ(names.table().str(columns[3].tokens[0]), "slow");
+   EXPECT_EQ(names.table().str(columns[3].tokens[1]), "fast");
+   EXPECT_EQ(columns[4].numbers[0], 0.0);
+   EXPECT_EQ(columns[4].numbers[1], 1.0);
+}
+
+TEST_F(gb2gc_extractor_test, extract__should_equal_selector__if_converted_to_variant)
+{
+   const std::vector<selector> selectors({ 
+      selector("name/2"), selector("name"), selector("real_time"), selector("label") });
+   const auto columns = column_extractor(selectors).extract(benchmarks, names, { 0, 1 });
+
+   for (auto i = 0u; i < selectors.size(); ++i)
+   {
+      for (auto row = 0u; row < 2u; ++row)
+      {
+         const auto expected = to_string(selectors[i](benchmarks[row]));
+         EXPECT_EQ(to_string(columns[i].value(row, names.table())), expected);
+      }
+   }
+}
+
+TEST_F(gb2gc_extractor_test, extract__should_throw__if_benchmark_lacks_selected_field)
+{
+   const std::vector<selector> selectors({ selector("name/1"), selector("cpu_time") });
+   EXPECT_THROW(column_extractor(selectors).extract(benchmarks, names, { 0 }), std::runtime_error);
+}
+
+TEST_F(gb2gc_extractor_test, extract__should_throw__if_benchmark_lacks_selected_parameter)
+{
+   const std::vector<selector> selectors({ selector("name/3"), selector("real_time") });
+   EXPECT_THROW(column_extractor(selectors).extract(benchmarks, names, { 0 }), std::runtime_error);
+}
@@ -0,0 +1,39 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include "file_glob.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_file_glob_test : public ::testing::Test
+{ };
+
+TEST_F(gb2gc_file_glob_test, is_glob__should_return_true__if_path_contains_wildcards)
+{
+   EXPECT_TRUE(is_glob("benchmark*.json"));
+   EXPECT_TRUE(is_glob("benchmark?.json"));
+   EXPECT_FALSE(is_glob("benchmark1.json"));
+}
+
+TEST_F(gb2gc_file_glob_test, expand_glob__should_return_pattern__if_not_a_glob)
+{
+   const auto paths = expand_glob("non_existent.json");
+   ASSERT_EQ(paths.size(), 1u);
+   EXPECT_EQ(paths[0], "non_existent.json");
+}
+
+TEST_F(gb2gc_file_glob_test, expand_glob__should_return_sorted_matches__if_glob)
+{
+   const auto paths = expand_glob("benchmark?.json");
+   ASSERT_EQ(paths.size(), 2u);
+   EXPECT_EQ(paths[0], "benchmark1.json");
+   EXPECT_EQ(paths[1], "benchmark2.json");
+}
+
+TEST_F(gb2gc_file_glob_test, expand_glob__should_return_empty__if_glob_without_matches)
+{
+   EXPECT_TRUE(expand_glob("non_existent*.json").empty());
+}
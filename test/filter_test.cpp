@@ -0,0 +1,87 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "filter.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_filter_test : public ::testing::Test
+{
+public:
+   static benchmark_filter make(std::initializer_list<std::string> patterns)
+   {
+      return benchmark_filter(std::vector<std::string>(patterns));
+   }
+};
+
+TEST_F(gb2gc_filter_test, ctor__should_pass_all__if_no_patterns)
+{
+   benchmark_filter filter;
+   EXPECT_TRUE(filter.empty());
+   EXPECT_TRUE(filter("BM_memcpy/8"));
+   EXPECT_TRUE(filter(""));
+}
+
+TEST_F(gb2gc_filter_test, call__should_compare_segments__if_literal_and_wildcard_segments)
+{
+   const auto filter = make({ "BM_memcpy/*" });
+   EXPECT_FALSE(filter.empty());
+   EXPECT_TRUE(filter("BM_memcpy/8"));
+   EXPECT_TRUE(filter("BM_memcpy/8/64"));
+   EXPECT_TRUE(filter("BM_memcpy"));
+   EXPECT_FALSE(filter("BM_memmove/8"));
+   EXPECT_FALSE(filter("BM_memcpy_large/8"));
+}
+
+TEST_F(gb2gc_filter_test, call__should_match_glob__if_segment_contains_wildcards)
+{
+   const auto filter = make({ "BM_mem*/?4" });
+   EXPECT_TRUE(filter("BM_memcpy/64"));
+   EXPECT_TRUE(filter("BM_memmove/64"));
+   EXPECT_FALSE(filter("BM_memcpy/8"));
+   EXPECT_FALSE(filter("BM_memcpy/512"));
+   EXPECT_FALSE(filter("BM_strcpy/64"));
+}
+
+TEST_F(gb2gc_filter_test, call__should_search_name__if_regex_pattern)
+{
+   const auto filter = make({ "re:mem(cpy|move)/[0-9]+$" });
+   EXPECT_TRUE(filter("BM_memcpy/64"));
+   EXPECT_TRUE(filter("BM_memmove/8"));
+   EXPECT_FALSE(filter("BM_memcpy/64/x"));
+   EXPECT_FALSE(filter("BM_memset/64"));
+}
+
+TEST_F(gb2gc_filter_test, call__should_pass_any_include__if_multiple_include_patterns)
+{
+   const auto filter = make({ "BM_memcpy", "re:^BM_memmove" });
+   EXPECT_TRUE(filter("BM_memcpy/8"));
+   EXPECT_TRUE(filter("BM_memmove/8"));
+   EXPECT_FALSE(filter("BM_memset/8"));
+}
+
+TEST_F(gb2gc_filter_test, call__should_reject__if_exclude_pattern_matches)
+{
+   const auto filter = make({ "BM_mem*", "-*/512", "-re:move" });
+   EXPECT_TRUE(filter("BM_memcpy/8"));
+   EXPECT_FALSE(filter("BM_memcpy/512"));
+   EXPECT_FALSE(filter("BM_memmove/8"));
+   EXPECT_FALSE(filter("BM_strcpy/8"));
+}
+
+TEST_F(gb2gc_filter_test, call__should_pass_all_not_excluded__if_only_exclude_patterns)
+{
+   const auto filter = make({ "-BM_memmove" });
+   EXPECT_TRUE(filter("BM_memcpy/8"));
+   EXPECT_FALSE(filter("BM_memmove/8"));
+}
+
+TEST_F(gb2gc_filter_test, ctor__should_throw__if_invalid_regex)
+{
+   EXPECT_THROW(make({ "re:BM_(memcpy" }), std::invalid_argument);
+}
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include "gb2gc.h"
+#include "snapshot.h"
 
 #include <algorithm>
 
@@ -93,3 +94,279 @@ TEST_F(gb2gc_generator_test, run__should_be_successful__if_bar_chart_and_valid_i
     EXPECT_TRUE(file_exists());
 }
 
+TEST_F(gb2gc_generator_test, run__should_create_and_reuse_snapshot__if_snapshot_option_given)
+{
+    const char* args[] =
+    {
+        "gb2gc.exe",
+        "-i", "benchmark1.json",
+        "-o", file.c_str(),
+        "-c", "line",
+        "-s", "name/2", "bytes_per_second",
+        "--snapshot"
+    };
+
+    const auto snapshot = "benchmark1.json.gb2gc";
+    std::remove(snapshot);
+    EXPECT_EQ(gb2gc::run(11, args), 0);
+    EXPECT_TRUE(std::ifstream(snapshot).good());
+
+    std::ifstream first(file);
+    const std::string expected((std::istreambuf_iterator<char>(first)),
+       std::istreambuf_iterator<char>());
+    first.close();
+
+    EXPECT_EQ(gb2gc::run(11, args), 0);
+    std::ifstream second(file);
+    const std::string actual((std::istreambuf_iterator<char>(second)),
+       std::istreambuf_iterator<char>());
+    EXPECT_EQ(actual, expected);
+    std::remove(snapshot);
+}
+
+TEST_F(gb2gc_generator_test, run__should_write_same_chart__if_multiple_inputs_read_from_snapshots)
+{
+    const char* args[] =
+    {
+        "gb2gc.exe",
+        "-i", "benchmark1.json", "benchmark2.json",
+        "-o", file.c_str(),
+        "-c", "bar",
+        "-s", "input_file", "real_time",
+        "--snapshot"
+    };
+    const auto read_file = [&]()
+    {
+        std::ifstream in(file);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+
+    EXPECT_EQ(gb2gc::run(11, args), 0);
+    const auto expected = read_file();
+    EXPECT_NE(expected.find("benchmark2.json"), std::string::npos);
+
+    EXPECT_EQ(gb2gc::run(12, args), 0); // creates snapshots
+    EXPECT_EQ(read_file(), expected);
+    EXPECT_EQ(gb2gc::run(12, args), 0); // reads snapshots
+    EXPECT_EQ(read_file(), expected);
+    std::remove("benchmark1.json.gb2gc");
+    std::remove("benchmark2.json.gb2gc");
+}
+
+TEST_F(gb2gc_generator_test, run__should_be_successful__if_multiple_input_files)
+{
+    const char* args[] =
+    {
+        "gb2gc.exe",
+        "-i", "benchmark1.json", "benchmark2.json",
+        "-o", file.c_str(),
+        "-c", "bar",
+        "-s", "name", "cpu_time"
+    };
+
+    EXPECT_EQ(gb2gc::run(11, args), 0);
+    EXPECT_TRUE(file_exists());
+}
+
+TEST_F(gb2gc_generator_test, parse_json__should_merge_in_order_and_tag_input_file__if_multiple_input_files)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "benchmark?.json", "-o", "out", "-c", "bar" };
+    ASSERT_EQ(opt.parse(7, args), 0);
+    ASSERT_EQ(opt.in_files().size(), 2u);
+
+    const auto first = parse_json(opt.in_files()[0], opt)["benchmarks"];
+    const auto second = parse_json(opt.in_files()[1], opt)["benchmarks"];
+    const auto merged = parse_json(opt.in_files(), opt)["benchmarks"];
+
+    ASSERT_EQ(merged.size(), first.size() + second.size());
+    EXPECT_EQ(merged[0]["name"], first[0]["name"]);
+    EXPECT_EQ(merged[0]["input_file"].get<std::string>(), "benchmark1.json");
+    EXPECT_EQ(merged[first.size()]["name"], second[0]["name"]);
+    EXPECT_EQ(merged[first.size()]["input_file"].get<std::string>(), "benchmark2.json");
+}
+
+TEST_F(gb2gc_generator_test, parse_data__should_group_series_in_order_of_appearance__if_benchmarks_interleaved)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "in", "-o", "out", "-c", "line", "-s", "name/1", "real_time" };
+    ASSERT_EQ(opt.parse(10, args), 0);
+
+    const auto result = nlohmann::json::parse(R"({ "benchmarks": [
+        { "name": "BM_B/1", "real_time": 1.0 },
+        { "name": "BM_A/1", "real_time": 2.0 },
+        { "name": "BM_B/2", "real_time": 3.0 },
+        { "name": "BM_A/2", "real_time": 4.0 } ] })");
+    const auto ds = parse_data(opt, result);
+
+    ASSERT_EQ(ds.cols(), 3u);
+    ASSERT_EQ(ds.rows(), 2u);
+    EXPECT_EQ(ds.get_col(1).name(), "BM_B/* real_time");
+    EXPECT_EQ(ds.get_col(2).name(), "BM_A/* real_time");
+    EXPECT_EQ(ds.get_col(1)[1], variant(3.0));
+    EXPECT_EQ(ds.get_col(2)[1], variant(4.0));
+}
+
+TEST_F(gb2gc_generator_test, parse_data__should_use_first_benchmark__if_series_has_duplicate_keys)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "in", "-o", "out", "-c", "line", "-s", "name/1", "real_time" };
+    ASSERT_EQ(opt.parse(10, args), 0);
+
+    const auto result = nlohmann::json::parse(R"({ "benchmarks": [
+        { "name": "BM_A/1", "real_time": 1.0 },
+        { "name": "BM_B/2", "real_time": 2.0 },
+        { "name": "BM_A/1", "real_time": 3.0 },
+        { "name": "BM_A/2", "real_time": 4.0 } ] })");
+    const auto ds = parse_data(opt, result);
+
+    ASSERT_EQ(ds.cols(), 3u);
+    ASSERT_EQ(ds.rows(), 2u);
+    EXPECT_EQ(ds.get_col(0)[0], variant(1.0));
+    EXPECT_EQ(ds.get_col(0)[1], variant(2.0));
+    EXPECT_EQ(ds.get_col(1)[0], variant(1.0));
+    EXPECT_EQ(ds.get_col(1)[1], variant(4.0));
+    EXPECT_EQ(ds.get_col(2)[0], variant());
+    EXPECT_EQ(ds.get_col(2)[1], variant(2.0));
+}
+
+TEST_F(gb2gc_generator_test, parse_data__should_order_rows_by_key__if_numeric_keys_out_of_order)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "in", "-o", "out", "-c", "line", "-s", "name/1", "real_time" };
+    ASSERT_EQ(opt.parse(10, args), 0);
+
+    const auto result = nlohmann::json::parse(R"({ "benchmarks": [
+        { "name": "BM_A/64", "real_time": 1.0 },
+        { "name": "BM_A/8", "real_time": 2.0 },
+        { "name": "BM_B/16", "real_time": 3.0 } ] })");
+    const auto ds = parse_data(opt, result);
+
+    ASSERT_EQ(ds.rows(), 3u);
+    EXPECT_EQ(ds.get_col(0)[0], variant(8.0));
+    EXPECT_EQ(ds.get_col(0)[1], variant(16.0));
+    EXPECT_EQ(ds.get_col(0)[2], variant(64.0));
+    EXPECT_EQ(ds.get_col(1)[0], variant(2.0));
+    EXPECT_EQ(ds.get_col(1)[1], variant());
+    EXPECT_EQ(ds.get_col(2)[1], variant(3.0));
+}
+
+TEST_F(gb2gc_generator_test, parse_data__should_aggregate_repetitions__if_aggregate_selected)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "in", "-o", "out", "-c", "line", 
+        "-s", "name/1", "real_time", "real_time:median", "real_time:max" };
+    ASSERT_EQ(opt.parse(12, args), 0);
+
+    const auto result = nlohmann::json::parse(R"({ "benchmarks": [
+        { "name": "BM_A/1", "run_type": "iteration", "real_time": 3.0 },
+        { "name": "BM_A/1", "run_type": "iteration", "real_time": 1.0 },
+        { "name": "BM_A/1", "run_type": "iteration", "real_time": 2.0 },
+        { "name": "BM_A/2", "run_type": "iteration", "real_time": 4.0 },
+        { "name": "BM_A/1_mean", "run_type": "aggregate", "real_time": 100.0 } ] })");
+    const auto ds = parse_data(opt, result);
+
+    ASSERT_EQ(ds.cols(), 4u);
+    ASSERT_EQ(ds.rows(), 2u);
+    EXPECT_EQ(ds.get_col(2).name(), "BM_A/* real_time median");
+    EXPECT_EQ(ds.get_col(1)[0], variant(3.0));
+    EXPECT_EQ(ds.get_col(2)[0], variant(2.0));
+    EXPECT_EQ(ds.get_col(3)[0], variant(3.0));
+    EXPECT_EQ(ds.get_col(2)[1], variant(4.0));
+}
+
+TEST_F(gb2gc_generator_test, parse_data__should_equal_parsed_json__if_read_from_snapshot)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "in", "-o", "out", "-c", "line",
+        "-s", "name/1", "real_time", "label", "real_time:median", "-f", "BM_A/*" };
+    ASSERT_EQ(opt.parse(14, args), 0);
+
+    const auto result = nlohmann::json::parse(R"({ "benchmarks": [
+        { "name": "BM_A/1", "run_type": "iteration", "real_time": 3, "label": "x" },
+        { "name": "BM_B/1", "run_type": "iteration", "real_time": 5, "label": "y" },
+        { "name": "BM_A/1", "run_type": "iteration", "real_time": 1.5, "label": "x" },
+        { "name": "BM_A/2", "run_type": "iteration", "real_time": 4, "label": "BM_z" },
+        { "name": "BM_A/1_mean", "run_type": "aggregate", "real_time": 100.0 } ] })");
+    input_signature signature;
+    signature.size = 1u;
+    const auto path = file + ".gb2gc";
+    ASSERT_TRUE(snapshot::write(path, signature, result["benchmarks"]));
+    snapshot snap;
+    ASSERT_TRUE(snap.open(path, signature));
+
+    const auto expected = parse_data(opt, result);
+    const auto actual = parse_data(opt, snap);
+    ASSERT_EQ(actual.cols(), expected.cols());
+    ASSERT_EQ(actual.rows(), expected.rows());
+    EXPECT_EQ(actual.rows(), 2u);
+    for (auto c = 0u; c < expected.cols(); ++c)
+    {
+        EXPECT_EQ(actual.get_col(c).name(), expected.get_col(c).name());
+        for (auto r = 0u; r < expected.rows(); ++r)
+            EXPECT_EQ(actual.get_col(c)[r], expected.get_col(c)[r]);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(gb2gc_generator_test, run__should_write_all_charts__if_manifest_given)
+{
+    const std::string bar = file + "_bar.html";
+    const std::string svg = file + "_line.svg";
+    {
+        std::ofstream manifest(file);
+        manifest << R"({ "charts": [
+            { "input": "benchmark1.json", "output": ")" << bar << R"(", "type": "bar",
+              "filter": "BM_SetInsert/*/8" },
+            { "input": [ "benchmark1.json", "benchmark2.json" ], "output": ")" << svg << R"(",
+              "type": "line", "svg": true } ] })";
+    }
+
+    auto read = [](const std::string& path)
+    {
+        std::ifstream f(path);
+        return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    };
+
+    const char* single_args[] = { "gb2gc.exe", "-i", "benchmark1.json", "-o", bar.c_str(),
+        "-c", "bar", "-f", "BM_SetInsert/*/8" };
+    EXPECT_EQ(gb2gc::run(9, single_args), 0);
+    const auto expected = read(bar);
+    std::remove(bar.c_str());
+
+    const char* manifest_args[] = { "gb2gc.exe", "--manifest", file.c_str() };
+    EXPECT_EQ(gb2gc::run(3, manifest_args), 0);
+
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(read(bar), expected);
+    EXPECT_NE(read(svg).find("<svg"), std::string::npos);
+
+    std::remove(bar.c_str());
+    std::remove(svg.c_str());
+}
+
+TEST_F(gb2gc_generator_test, run__should_fail__if_manifest_combined_with_other_options)
+{
+    const char* args[] = { "gb2gc.exe", "--manifest", "charts.json", "-c", "bar" };
+    EXPECT_NE(gb2gc::run(5, args), 0);
+}
+
+TEST_F(gb2gc_generator_test, parse_data__should_throw_naming_attribute__if_benchmark_name_missing)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "in", "-o", "out", "-c", "line" };
+    ASSERT_EQ(opt.parse(7, args), 0);
+
+    const auto result = nlohmann::json::parse(R"({ "benchmarks": [ { "real_time": 1.0 } ] })");
+    try
+    {
+        parse_data(opt, result);
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_NE(std::string(e.what()).find("'name'"), std::string::npos);
+    }
+}
+
+TEST_F(gb2gc_generator_test, parse_data__should_throw_naming_attribute__if_benchmark_name_not_string)
+{
+    const char* args[] = { "gb2gc.exe", "-i", "in", "-o", "out", "-c", "line" };
+    ASSERT_EQ(opt.parse(7, args), 0);
+
+    const auto result = nlohmann::json::parse(R"({ "benchmarks": [ { "name": 1, "real_time": 1.0 } ] })");
+    EXPECT_THROW(parse_data(opt, result), std::runtime_error);
+}
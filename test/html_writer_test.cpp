@@ -0,0 +1,108 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "html_writer.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_html_writer_test : public ::testing::Test
+{
+protected:
+   output_sink sink;
+   format fmt;
+};
+
+TEST_F(gb2gc_html_writer_test, close__should_write_single_line__if_element_is_empty)
+{
+   html_writer html(sink, fmt);
+   html.open("div").attr("id", "chart").close();
+   EXPECT_EQ(sink.str(), "<div id=\"chart\"></div>\n");
+}
+
+TEST_F(gb2gc_html_writer_test, open__should_use_default_format__if_format_not_given)
+{
+   html_writer html(sink);
+   html.open("div").open("span").close();
+   html.close();
+   EXPECT_EQ(sink.str(), "<div>\n  <span></span>\n</div>\n");
+}
+
+TEST_F(gb2gc_html_writer_test, open__should_indent_children__if_nested)
+{
+   html_writer html(sink, fmt);
+   html.open("html");
+   html.open("head").open("script").attr("src", "a.js").close().close();
+   html.comment("The body");
+   html.open("body");
+   html.close_all();
+   EXPECT_EQ(html.depth(), 0u);
+   EXPECT_EQ(sink.str(),
+      "<html>\n"
+      "  <head>\n"
+      "    <script src=\"a.js\"></script>\n"
+      "  </head>\n"
+      "  <!-- The body -->\n"
+      "  <body></body>\n"
+      "</html>\n");
+}
+
+TEST_F(gb2gc_html_writer_test, text__should_indent_each_line__if_multiline)
+{
+   html_writer html(sink, fmt, 1);
+   html.open("p").text("first\nsecond\n").close();
+   EXPECT_EQ(sink.str(),
+      "  <p>\n"
+      "    first\n"
+      "    second\n"
+      "  </p>\n");
+}
+
+TEST_F(gb2gc_html_writer_test, content__should_invoke_writer_with_content_level__if_given)
+{
+   html_writer html(sink, fmt);
+   html.open("script").content([](output_sink& out, const format& f, size_t level)
+   {
+      out << f.indent(level) << "var x = " << level << ';';
+   }).close();
+   EXPECT_EQ(sink.str(),
+      "<script>\n"
+      "  var x = 1;\n"
+      "</script>\n");
+}
+
+TEST_F(gb2gc_html_writer_test, comment__should_write_nothing__if_comments_stripped)
+{
+   fmt.strip_comments = true;
+   html_writer html(sink, fmt);
+   html.comment("hidden").open("a").close();
+   EXPECT_EQ(sink.str(), "<a></a>\n");
+}
+
+TEST_F(gb2gc_html_writer_test, attr__should_throw_logic_error__if_element_has_content)
+{
+   html_writer html(sink, fmt);
+   html.open("a").text("x");
+   EXPECT_THROW(html.attr("id", "y"), std::logic_error);
+}
+
+TEST_F(gb2gc_html_writer_test, close__should_throw_logic_error__if_no_element_is_open)
+{
+   html_writer html(sink, fmt);
+   EXPECT_THROW(html.close(), std::logic_error);
+}
+
+TEST_F(gb2gc_html_writer_test, inline_text__should_write_element_on_single_line__if_element_just_opened)
+{
+   html_writer html(sink, fmt);
+   html.open("svg").open("text").attr("x", "1").inline_text("label");
+   html.close_all();
+   EXPECT_EQ(sink.str(),
+      "<svg>\n"
+      "  <text x=\"1\">label</text>\n"
+      "</svg>\n");
+}
@@ -0,0 +1,83 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "manifest.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_manifest_test : public ::testing::Test
+{ };
+
+TEST_F(gb2gc_manifest_test, manifest_args__should_map_keys_to_options__if_valid_chart)
+{
+   const auto chart = nlohmann::json::parse(R"({
+      "svg": true, "compact": false, "title": "T", "width": 800,
+      "select": [ "name/2", "real_time" ], "input": [ "a.json", "b.json" ],
+      "output": "a.html", "type": "line", "args": [ "--max-points", "100" ] })");
+
+   const std::vector<std::string> expected({ "-i", "a.json", "b.json", "-o", "a.html",
+      "-c", "line", "-t", "T", "-w", "800", "-s", "name/2", "real_time", "--svg",
+      "--max-points", "100" });
+   EXPECT_EQ(manifest_args(chart), expected);
+}
+
+TEST_F(gb2gc_manifest_test, manifest_args__should_throw__if_unknown_key)
+{
+   EXPECT_THROW(manifest_args(nlohmann::json::parse(R"({ "colour": "red" })")),
+      std::invalid_argument);
+}
+
+TEST_F(gb2gc_manifest_test, manifest_args__should_throw__if_flag_is_not_boolean)
+{
+   EXPECT_THROW(manifest_args(nlohmann::json::parse(R"({ "svg": "yes" })")),
+      std::invalid_argument);
+}
+
+TEST_F(gb2gc_manifest_test, parse__should_list_distinct_inputs_in_order_of_first_use__if_inputs_shared)
+{
+   manifest m;
+   ASSERT_EQ(m.parse(nlohmann::json::parse(R"({ "charts": [
+      { "input": "benchmark2.json", "output": "a.html", "type": "bar" },
+      { "input": [ "benchmark1.json", "benchmark2.json" ], "output": "b.html", "type": "line" },
+      { "input": "benchmark1.json", "output": "c.html", "type": "line", "dashboard": true } ] })")), 0);
+
+   ASSERT_EQ(m.charts().size(), 3u);
+   EXPECT_EQ(m.inputs(), std::vector<std::string>({ "benchmark2.json", "benchmark1.json" }));
+   EXPECT_EQ(m.charts()[0].inputs, std::vector<std::size_t>({ 0 }));
+   EXPECT_EQ(m.charts()[1].inputs, std::vector<std::size_t>({ 1, 0 }));
+   EXPECT_EQ(m.charts()[2].inputs, std::vector<std::size_t>({ 1 }));
+   EXPECT_EQ(m.charts()[1].options.chart_type(), googlechart::visualization::line);
+   EXPECT_TRUE(m.charts()[2].options.dashboard());
+}
+
+TEST_F(gb2gc_manifest_test, parse__should_fail__if_charts_share_output)
+{
+   manifest m;
+   EXPECT_NE(m.parse(nlohmann::json::parse(R"({ "charts": [
+      { "input": "benchmark1.json", "output": "a.html", "type": "bar" },
+      { "input": "benchmark2.json", "output": "a.html", "type": "bar" } ] })")), 0);
+}
+
+TEST_F(gb2gc_manifest_test, parse__should_fail__if_charts_missing)
+{
+   manifest m;
+   EXPECT_NE(m.parse(nlohmann::json::parse(R"({ "chart": [] })")), 0);
+}
+
+TEST_F(gb2gc_manifest_test, parse__should_fail__if_chart_options_invalid)
+{
+   manifest m;
+   EXPECT_NE(m.parse(nlohmann::json::parse(R"({ "charts": [
+      { "input": "benchmark1.json", "output": "a.html", "type": "pie" } ] })")), 0);
+}
+
+TEST_F(gb2gc_manifest_test, read__should_fail__if_file_does_not_exist)
+{
+   manifest m;
+   EXPECT_NE(m.read("no_such_manifest.json"), 0);
+}
@@ -0,0 +1,52 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include "mapped_file.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_mapped_file_test : public ::testing::Test
+{ };
+
+TEST_F(gb2gc_mapped_file_test, ctor__should_not_be_open__if_default_constructed)
+{
+   mapped_file map;
+
+   EXPECT_FALSE(map.is_open());
+   EXPECT_EQ(map.data(), nullptr);
+   EXPECT_EQ(map.size(), 0u);
+}
+
+TEST_F(gb2gc_mapped_file_test, open__should_fail__if_non_existent_file)
+{
+   mapped_file map;
+
+   EXPECT_FALSE(map.open("non_existent.json"));
+   EXPECT_FALSE(map.is_open());
+}
+
+#if GB2GC_HAS_MMAP
+TEST_F(gb2gc_mapped_file_test, open__should_map_file_content__if_regular_file)
+{
+   std::ifstream in("benchmark1.json", std::ios::in | std::ios::binary);
+   const std::string expected((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+
+   mapped_file map;
+   ASSERT_TRUE(map.open("benchmark1.json"));
+   EXPECT_EQ(std::string(map.data(), map.size()), expected);
+
+   mapped_file moved(std::move(map));
+   EXPECT_FALSE(map.is_open());
+   EXPECT_TRUE(moved.is_open());
+
+   moved.close();
+   EXPECT_FALSE(moved.is_open());
+}
+#endif
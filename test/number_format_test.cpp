@@ -0,0 +1,96 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "number_format.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_number_format_test : public ::testing::Test
+{
+protected:
+   template<class T>
+   static std::string format(T value)
+   {
+      char buffer[max_number_chars];
+      return std::string(buffer, format_number(buffer, value));
+   }
+};
+
+TEST_F(gb2gc_number_format_test, format_number__should_write_integer__if_integral)
+{
+   EXPECT_EQ(format(0ll), "0");
+   EXPECT_EQ(format(-42ll), "-42");
+   EXPECT_EQ(format((std::numeric_limits<long long>::min)()), "-9223372036854775808");
+   EXPECT_EQ(format((std::numeric_limits<unsigned long long>::max)()), "18446744073709551615");
+}
+
+TEST_F(gb2gc_number_format_test, format_number__should_write_javascript_notation__if_floating_point)
+{
+   EXPECT_EQ(format(1.0), "1");
+   EXPECT_EQ(format(-2.5), "-2.5");
+   EXPECT_EQ(format(123456.789), "123456.789");
+   EXPECT_EQ(format(3.2e-05), "0.000032");
+   EXPECT_EQ(format(1e-06), "0.000001");
+   EXPECT_EQ(format(1e-07), "1e-7");
+   EXPECT_EQ(format(1.5e-09), "1.5e-9");
+   EXPECT_EQ(format(1e20), "100000000000000000000");
+   EXPECT_EQ(format(1e21), "1e+21");
+   EXPECT_EQ(format(5e-324), "5e-324");
+   EXPECT_EQ(format(1.7976931348623157e308), "1.7976931348623157e+308");
+}
+
+TEST_F(gb2gc_number_format_test, format_number__should_write_special_values__if_not_finite_or_zero)
+{
+   EXPECT_EQ(format(0.0), "0");
+   EXPECT_EQ(format(-0.0), "0");
+   EXPECT_EQ(format(std::numeric_limits<double>::quiet_NaN()), "NaN");
+   EXPECT_EQ(format(std::numeric_limits<double>::infinity()), "Infinity");
+   EXPECT_EQ(format(-std::numeric_limits<double>::infinity()), "-Infinity");
+}
+
+TEST_F(gb2gc_number_format_test, format_number__should_write_float_digits__if_float)
+{
+   EXPECT_EQ(format(0.1f), "0.1");
+   EXPECT_EQ(format(1.23456789f), "1.2345679");
+   EXPECT_EQ(format(0.1l), "0.1");
+}
+
+TEST_F(gb2gc_number_format_test, format_number__should_round_trip__if_random_finite_double)
+{
+   std::mt19937_64 rng(2020);
+   for (auto i = 0; i < 100000; ++i)
+   {
+      const auto bits = rng();
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if (value != value || value - value != 0.0) // skip NaN and infinity
+         continue;
+      const auto s = format(value);
+      ASSERT_EQ(std::strtod(s.c_str(), nullptr), value) << s;
+   }
+}
+
+TEST_F(gb2gc_number_format_test, format_number__should_round_trip__if_random_finite_float)
+{
+   std::mt19937 rng(2020);
+   for (auto i = 0; i < 100000; ++i)
+   {
+      const auto bits = static_cast<std::uint32_t>(rng());
+      float value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if (value != value || value - value != 0.0f)
+         continue;
+      const auto s = format(value);
+      ASSERT_EQ(std::strtof(s.c_str(), nullptr), value) << s;
+   }
+}
@@ -98,3 +98,106 @@ TEST_F(gb2gc_options_test, parse__should_fail__if_missing_required_arg)
 
 // TODO Setup stream redirect to verify error messages
 
+TEST_F(gb2gc_options_test, parse__should_enable_snapshot__if_snapshot_long_option_given)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out", "--snapshot" };
+   EXPECT_FALSE(opt.snapshot());
+   EXPECT_EQ(opt.parse(8, args), 0);
+   EXPECT_TRUE(opt.snapshot());
+}
+
+TEST_F(gb2gc_options_test, parse__should_enable_compact_output__if_compact_long_option_given)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out", "--compact" };
+   EXPECT_FALSE(opt.dom_options().compact);
+   EXPECT_EQ(opt.parse(8, args), 0);
+   EXPECT_TRUE(opt.dom_options().compact);
+}
+
+TEST_F(gb2gc_options_test, parse__should_set_max_points__if_max_points_long_option_given)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out", "--max-points", "500" };
+   EXPECT_EQ(opt.max_points(), 0u);
+   EXPECT_EQ(opt.parse(9, args), 0);
+   EXPECT_EQ(opt.max_points(), 500u);
+}
+
+TEST_F(gb2gc_options_test, parse__should_fail__if_max_points_given_for_bar_chart)
+{
+   const char* args[] = { "gb2gc", "-c", "bar", "-i", "in", "-o", "out", "--max-points", "500" };
+   EXPECT_NE(opt.parse(9, args), 0);
+}
+
+TEST_F(gb2gc_options_test, parse__should_fail__if_max_points_given_for_histogram)
+{
+   const char* args[] = { "gb2gc", "-c", "histogram", "-i", "in", "-o", "out", "--max-points", "500" };
+   EXPECT_NE(opt.parse(9, args), 0);
+}
+
+TEST_F(gb2gc_options_test, parse__should_set_max_points__if_max_points_given_for_scatter_chart)
+{
+   const char* args[] = { "gb2gc", "-c", "scatter", "-i", "in", "-o", "out", "--max-points", "500" };
+   EXPECT_EQ(opt.parse(9, args), 0);
+   EXPECT_EQ(opt.max_points(), 500u);
+}
+
+TEST_F(gb2gc_options_test, parse__should_enable_dashboard__if_dashboard_long_option_given)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out", "--dashboard" };
+   EXPECT_FALSE(opt.dashboard());
+   EXPECT_EQ(opt.parse(8, args), 0);
+   EXPECT_TRUE(opt.dashboard());
+}
+
+TEST_F(gb2gc_options_test, parse__should_fail__if_unknown_long_option)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out", "--unknown" };
+   EXPECT_NE(opt.parse(8, args), 0);
+}
+
+TEST_F(gb2gc_options_test, parse__should_accept_multiple_input_files__if_multiple_arguments)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "a.json", "b.json", "-o", "out" };
+   EXPECT_EQ(opt.parse(8, args), 0);
+   ASSERT_EQ(opt.in_files().size(), 2u);
+   EXPECT_EQ(opt.in_files()[0], "a.json");
+   EXPECT_EQ(opt.in_files()[1], "b.json");
+   EXPECT_EQ(opt.in_file(), "a.json");
+}
+
+TEST_F(gb2gc_options_test, parse__should_fail__if_input_glob_without_matches)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "non_existent*.json", "-o", "out" };
+   EXPECT_NE(opt.parse(7, args), 0);
+}
+
+TEST_F(gb2gc_options_test, parse__should_compile_filter__if_multiple_filter_patterns)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out",
+      "-f", "BM_mem*", "-BM_memmove" };
+   EXPECT_FALSE(opt.has_filter());
+   EXPECT_EQ(opt.parse(10, args), 0);
+   EXPECT_TRUE(opt.has_filter());
+   EXPECT_TRUE(opt.filter()("BM_memcpy/8"));
+   EXPECT_FALSE(opt.filter()("BM_memmove/8"));
+}
+
+TEST_F(gb2gc_options_test, parse__should_fail__if_invalid_filter_regex)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out", "-f", "re:(" };
+   EXPECT_NE(opt.parse(9, args), 0);
+}
+
+TEST_F(gb2gc_options_test, parse__should_fail__if_invalid_aggregate)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out", 
+      "-s", "name/1", "real_time:p101" };
+   EXPECT_NE(opt.parse(10, args), 0);
+}
+
+TEST_F(gb2gc_options_test, parse__should_fail__if_key_selector_aggregated)
+{
+   const char* args[] = { "gb2gc", "-c", "line", "-i", "in", "-o", "out",
+      "-s", "name/1:mean", "real_time" };
+   EXPECT_NE(opt.parse(10, args), 0);
+}
@@ -0,0 +1,130 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "output_sink.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_output_sink_test : public ::testing::Test
+{
+protected:
+   static std::string read_file(const char* path)
+   {
+      std::ifstream file(path, std::ios::in | std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(file),
+         std::istreambuf_iterator<char>());
+   }
+
+   const char* path = "output_sink_test.txt";
+
+   void TearDown() override
+   {
+      std::remove(path);
+   }
+};
+
+TEST_F(gb2gc_output_sink_test, append__should_collect_output__if_memory_sink)
+{
+   output_sink sink;
+   sink << "abc" << std::string("def") << 'g';
+   sink.append("hij", 2);
+   EXPECT_EQ(sink.str(), "abcdefghi");
+}
+
+TEST_F(gb2gc_output_sink_test, indent__should_append_spaces__if_count_exceeds_precomputed_indentation)
+{
+   output_sink sink;
+   sink.indent(0);
+   sink << '|';
+   sink.indent(3);
+   sink << '|';
+   sink.indent(200);
+   sink << '|';
+   EXPECT_EQ(sink.str(), "|   |" + std::string(200, ' ') + "|");
+}
+
+TEST_F(gb2gc_output_sink_test, operator_shift__should_format_numbers__if_number)
+{
+   output_sink sink;
+   sink << 1 << ' ' << -2L << ' ' << 3u << ' ' << 0.5f << ' ' << 1e21 << ' ' << 0.1;
+   EXPECT_EQ(sink.str(), "1 -2 3 0.5 1e+21 0.1");
+}
+
+TEST_F(gb2gc_output_sink_test, flush__should_write_all_output_in_order__if_stream_sink)
+{
+   std::string expected;
+   std::ostringstream os;
+   {
+      output_sink sink(os);
+      const std::string block(output_sink::default_capacity, 'x');
+      for (auto i = 0; i < 1000; ++i)
+      {
+         sink << i << ',';
+         expected += std::to_string(i) + ',';
+      }
+      sink.append(block);
+      expected += block;
+      sink << "end";
+      expected += "end";
+      sink.flush();
+      EXPECT_EQ(sink.str(), "");
+   }
+   EXPECT_EQ(os.str(), expected);
+}
+
+TEST_F(gb2gc_output_sink_test, destructor__should_flush_pending_output__if_not_flushed)
+{
+   std::ostringstream os;
+   {
+      output_sink sink(os);
+      sink << "pending";
+      EXPECT_EQ(os.str(), "");
+   }
+   EXPECT_EQ(os.str(), "pending");
+}
+
+TEST_F(gb2gc_output_sink_test, open__should_write_to_file__if_path_is_writable)
+{
+   std::string expected;
+   {
+      auto sink = output_sink::open(path);
+      for (auto i = 0; i < 100000; ++i)
+      {
+         sink << "row " << i << '\n';
+         expected += "row " + std::to_string(i) + '\n';
+      }
+      const std::string block(output_sink::default_capacity * 2, 'y');
+      sink.append(block);
+      expected += block;
+      sink.flush();
+   }
+   EXPECT_EQ(read_file(path), expected);
+}
+
+TEST_F(gb2gc_output_sink_test, open__should_throw_runtime_error__if_path_cannot_be_opened)
+{
+   EXPECT_THROW(output_sink::open("non/existing/directory/file.html"), std::runtime_error);
+}
+
+TEST_F(gb2gc_output_sink_test, move_constructor__should_transfer_pending_output__if_moved)
+{
+   std::ostringstream os;
+   {
+      output_sink sink(os);
+      sink << "moved";
+      output_sink other(std::move(sink));
+      other << " once";
+   }
+   EXPECT_EQ(os.str(), "moved once");
+}
@@ -0,0 +1,194 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "reader.h" // Subject under test (SUT)
+
+#if GB2GC_HAS_MMAP
+#include <sys/stat.h>
+#endif
+
+using namespace gb2gc;
+
+class gb2gc_reader_test : public ::testing::Test
+{
+public:
+   void read(const std::string& content, std::vector<std::string> fields = {})
+   {
+      std::istringstream in(content);
+      escape_streambuf escaped(in.rdbuf());
+      std::istream stream(&escaped);
+
+      benchmark_reader reader(std::move(fields),
+         [&](nlohmann::json&& bm) { benchmarks.emplace_back(std::move(bm)); });
+      nlohmann::json::sax_parse(stream, &reader);
+   }
+
+   std::vector<nlohmann::json> benchmarks;
+
+   static const char* content;
+};
+
+const char* gb2gc_reader_test::content =
+   "{\n"
+   "  \"context\": { \"date\": \"2015/03/17\", \"caches\": [ { \"level\": 1 } ] },\n"
+   "  \"benchmarks\": [\n"
+   "    { \"name\": \"BM_A/1\", \"iterations\": 10, \"cpu_time\": 1.5, \"real_time\": 2 },\n"
+   "    { \"name\": \"BM_B\\\\C/2\", \"cpu_time\": 3, \"nested\": { \"x\": 1 } }\n"
+   "  ]\n"
+   "}\n";
+
+TEST_F(gb2gc_reader_test, read__should_retain_all_scalar_fields__if_no_fields_specified)
+{
+   read(content);
+
+   ASSERT_EQ(benchmarks.size(), 2u);
+   EXPECT_EQ(benchmarks[0].size(), 4u);
+   EXPECT_EQ(benchmarks[0]["name"].get<std::string>(), "BM_A/1");
+   EXPECT_EQ(benchmarks[0]["iterations"].get<int>(), 10);
+   EXPECT_EQ(benchmarks[0]["cpu_time"].get<double>(), 1.5);
+   EXPECT_EQ(benchmarks[1].size(), 2u);
+   EXPECT_EQ(benchmarks[1].count("nested"), 0u);
+}
+
+TEST_F(gb2gc_reader_test, read__should_only_retain_specified_fields__if_fields_specified)
+{
+   read(content, { "name", "cpu_time" });
+
+   ASSERT_EQ(benchmarks.size(), 2u);
+   EXPECT_EQ(benchmarks[0].size(), 2u);
+   EXPECT_EQ(benchmarks[0].count("real_time"), 0u);
+   EXPECT_EQ(benchmarks[0]["cpu_time"].get<double>(), 1.5);
+   EXPECT_EQ(benchmarks[1]["cpu_time"].get<double>(), 3.0);
+}
+
+TEST_F(gb2gc_reader_test, read__should_replace_backslashes__if_unescaped_backslashes_in_input)
+{
+   read("{ \"benchmarks\": [ { \"name\": \"BM_B\\C/2\" } ] }");
+
+   ASSERT_EQ(benchmarks.size(), 1u);
+   EXPECT_EQ(benchmarks[0]["name"].get<std::string>(), "BM_B/C/2");
+}
+
+TEST_F(gb2gc_reader_test, read__should_throw__if_invalid_json)
+{
+   EXPECT_THROW(read("{ \"benchmarks\": [ { \"name\": } ] }"), std::runtime_error);
+}
+
+TEST_F(gb2gc_reader_test, escaped_view_streambuf__should_replace_backslashes__if_viewing_memory_in_place)
+{
+   const std::string content("a\\b\\\\c");
+   escaped_view_streambuf buf(content.data(), content.size());
+   std::istream stream(&buf);
+
+   std::string result((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+   EXPECT_EQ(result, "a/b//c");
+   EXPECT_EQ(content, "a\\b\\\\c");
+}
+
+TEST_F(gb2gc_reader_test, benchmark_input__should_map_file__if_regular_file_and_mmap_supported)
+{
+   benchmark_input in("benchmark1.json");
+   EXPECT_EQ(in.is_mapped(), GB2GC_HAS_MMAP != 0);
+
+   std::istream stream(in.rdbuf());
+   benchmark_reader reader({ "name" },
+      [&](nlohmann::json&& bm) { benchmarks.emplace_back(std::move(bm)); });
+   nlohmann::json::sax_parse(stream, &reader);
+   EXPECT_EQ(benchmarks.size(), 6u);
+}
+
+#if GB2GC_HAS_MMAP
+TEST_F(gb2gc_reader_test, benchmark_input__should_read_once__if_named_pipe)
+{
+   const char* path = "benchmark_input_test.fifo";
+   std::remove(path);
+   ASSERT_EQ(::mkfifo(path, 0600), 0);
+
+   // Opening either end of a pipe blocks until the other end is opened
+   std::thread writer([&]()
+   {
+      std::ofstream out(path, std::ios::out | std::ios::binary);
+      out << content;
+   });
+
+   {
+      benchmark_input in(path);
+      EXPECT_FALSE(in.is_mapped());
+
+      std::istream stream(in.rdbuf());
+      benchmark_reader reader({ "name" },
+         [&](nlohmann::json&& bm) { benchmarks.emplace_back(std::move(bm)); });
+      nlohmann::json::sax_parse(stream, &reader);
+   }
+   writer.join();
+   std::remove(path);
+
+   EXPECT_EQ(benchmarks.size(), 2u);
+}
+#endif
+
+TEST_F(gb2gc_reader_test, benchmark_input__should_throw__if_non_existent_file)
+{
+   EXPECT_THROW(benchmark_input("non_existent.json"), std::runtime_error);
+}
+
+// Stream buffer handing out one chunk of content per underflow to simulate
+// reading from a pipe where data becomes available incrementally.
+class chunked_streambuf : public std::streambuf
+{
+public:
+   explicit chunked_streambuf(std::vector<std::string> chunks)
+      : chunks_(std::move(chunks)), next_(0)
+   { }
+
+   std::size_t consumed() const { return next_; }
+
+protected:
+   int_type underflow() override
+   {
+      if (gptr() < egptr())
+         return traits_type::to_int_type(*gptr());
+      if (next_ == chunks_.size())
+         return traits_type::eof();
+      auto& chunk = chunks_[next_++];
+      setg(&chunk[0], &chunk[0], &chunk[0] + chunk.size());
+      return traits_type::to_int_type(*gptr());
+   }
+
+private:
+   std::vector<std::string> chunks_;
+   std::size_t              next_;
+};
+
+TEST_F(gb2gc_reader_test, read__should_deliver_benchmark__as_soon_as_benchmark_is_available)
+{
+   chunked_streambuf source({
+      "{ \"benchmarks\": [ { \"name\": \"BM_A\" },",
+      " { \"name\": \"BM_B\" }",
+      " ] }" });
+   escape_streambuf escaped(&source);
+   std::istream stream(&escaped);
+
+   std::vector<std::size_t> consumed;
+   benchmark_reader reader({},
+      [&](nlohmann::json&&) { consumed.push_back(source.consumed()); });
+   nlohmann::json::sax_parse(stream, &reader);
+
+   ASSERT_EQ(consumed.size(), 2u);
+   EXPECT_EQ(consumed[0], 1u);
+   EXPECT_EQ(consumed[1], 2u);
+}
+
+TEST_F(gb2gc_reader_test, is_standard_input__should_return_true__if_dash)
+{
+   EXPECT_TRUE(is_standard_input("-"));
+   EXPECT_FALSE(is_standard_input("benchmark1.json"));
+}
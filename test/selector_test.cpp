@@ -78,3 +78,15 @@ TEST_F(gb2gc_selector_test,
    selector s("non_existent/1");
    EXPECT_THROW(s(*benchmarks->begin()), std::runtime_error);
 }
+
+TEST_F(gb2gc_selector_test,
+   is_aggregated__should_be_true__if_key_has_aggregate_suffix)
+{
+   selector s("real_time:p90");
+   EXPECT_TRUE(s.is_aggregated());
+   EXPECT_FALSE(s.is_parameterized());
+   EXPECT_EQ(s.key(), "real_time");
+   EXPECT_EQ(s.aggregation().kind(), aggregate::function::percentile);
+   EXPECT_EQ(s.aggregation().percentile(), 90.0);
+   EXPECT_FALSE(selector("name/1").is_aggregated());
+}
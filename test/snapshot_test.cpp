@@ -0,0 +1,205 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include "snapshot.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_snapshot_test : public ::testing::Test
+{
+public:
+   void SetUp()
+   {
+      signature.size = 1234u;
+      signature.mtime = 5678;
+      signature.hash = 0xabcdefu;
+
+      benchmarks = nlohmann::json::parse(R"([
+         { "name": "BM_A/1", "iterations": 10, "cpu_time": 1.5, "error_occurred": false },
+         { "name": "BM_A/2", "iterations": 20, "cpu_time": 3, "label": "x" }
+      ])");
+   }
+
+   void TearDown()
+   {
+      std::remove(path);
+   }
+
+   std::vector<nlohmann::json> read(const std::vector<std::string>& fields = {})
+   {
+      std::vector<nlohmann::json> result;
+      snap.read(fields, [&](nlohmann::json&& bm) { result.emplace_back(std::move(bm)); });
+      return result;
+   }
+
+   const char*     path = "test.json.gb2gc";
+   input_signature signature;
+   nlohmann::json  benchmarks;
+   snapshot        snap;
+};
+
+TEST_F(gb2gc_snapshot_test, read__should_reconstruct_all_fields__if_written_and_opened_with_same_signature)
+{
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+   ASSERT_TRUE(snap.open(path, signature));
+   EXPECT_EQ(snap.rows(), 2u);
+   EXPECT_EQ(snap.cols(), 5u);
+
+   auto result = read();
+   ASSERT_EQ(result.size(), 2u);
+   EXPECT_EQ(result[0]["name"].get<std::string>(), "BM_A/1");
+   EXPECT_EQ(result[0]["iterations"].get<long long>(), 10);
+   EXPECT_EQ(result[0]["cpu_time"].get<double>(), 1.5);
+   EXPECT_EQ(result[0]["error_occurred"].get<bool>(), false);
+   EXPECT_EQ(result[0].count("label"), 0u);
+   EXPECT_EQ(result[1]["cpu_time"].get<double>(), 3.0);
+   EXPECT_EQ(result[1]["label"].get<std::string>(), "x");
+   EXPECT_EQ(result[1].count("error_occurred"), 0u);
+}
+
+TEST_F(gb2gc_snapshot_test, read__should_only_reconstruct_given_fields__if_fields_specified)
+{
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+   ASSERT_TRUE(snap.open(path, signature));
+
+   auto result = read({ "name", "cpu_time" });
+   ASSERT_EQ(result.size(), 2u);
+   EXPECT_EQ(result[0].size(), 2u);
+   EXPECT_EQ(result[1].size(), 2u);
+}
+
+TEST_F(gb2gc_snapshot_test, value__should_read_mapped_columns__if_field_present)
+{
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+   ASSERT_TRUE(snap.open(path, signature));
+   ASSERT_EQ(snap.size(), 2u);
+   EXPECT_EQ(snap.field("unknown"), snapshot::npos);
+
+   const auto name = snap.value(snap.field("name"), 1);
+   EXPECT_EQ(name.type, field_value::kind::string);
+   EXPECT_EQ(std::string(name.data, name.size), "BM_A/2");
+   EXPECT_EQ(snap.value(snap.field("iterations"), 1).type, field_value::kind::number);
+   EXPECT_EQ(snap.value(snap.field("iterations"), 1).number, 20.0);
+   EXPECT_EQ(snap.value(snap.field("cpu_time"), 0).number, 1.5);
+   EXPECT_EQ(snap.value(snap.field("error_occurred"), 0).type, field_value::kind::boolean);
+   EXPECT_EQ(snap.value(snap.field("error_occurred"), 0).number, 0.0);
+   EXPECT_EQ(snap.value(snap.field("error_occurred"), 1).type, field_value::kind::missing);
+}
+
+TEST_F(gb2gc_snapshot_test, open__should_fail__if_signature_differs)
+{
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+
+   auto other = signature;
+   other.hash += 1u;
+   EXPECT_FALSE(snap.open(path, other));
+   other = signature;
+   other.mtime += 1;
+   EXPECT_FALSE(snap.open(path, other));
+   other = signature;
+   other.size += 1u;
+   EXPECT_FALSE(snap.open(path, other));
+}
+
+TEST_F(gb2gc_snapshot_test, open__should_fail__if_snapshot_truncated)
+{
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+   std::string content;
+   {
+      std::ifstream in(path, std::ios::in | std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+   }
+   {
+      std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+      out.write(content.data(), static_cast<std::streamsize>(content.size() / 2));
+   }
+   EXPECT_FALSE(snap.open(path, signature));
+}
+
+TEST_F(gb2gc_snapshot_test, open__should_fail__if_string_offset_out_of_range)
+{
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+   std::string content;
+   {
+      std::ifstream in(path, std::ios::in | std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+   }
+
+   // Point the end of the first string far beyond the string table, the
+   // string table offset is stored at byte 48 of the header
+   std::uint64_t strings_offset;
+   ASSERT_GT(content.size(), 56u);
+   std::memcpy(&strings_offset, &content[48], sizeof(strings_offset));
+   const std::uint32_t offset = 0x7fffffffu;
+   ASSERT_GT(content.size(), strings_offset + 16u);
+   std::memcpy(&content[static_cast<std::size_t>(strings_offset) + 12u], &offset, sizeof(offset));
+   {
+      std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+      out.write(content.data(), static_cast<std::streamsize>(content.size()));
+   }
+
+   EXPECT_FALSE(snap.open(path, signature));
+}
+
+TEST_F(gb2gc_snapshot_test, open__should_fail__if_non_existent)
+{
+   EXPECT_FALSE(snap.open("non_existent.gb2gc", signature));
+}
+
+TEST_F(gb2gc_snapshot_test, write__should_replace_snapshot__if_snapshot_exists)
+{
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+   benchmarks.erase(1);
+   ASSERT_TRUE(snapshot::write(path, signature, benchmarks));
+   ASSERT_TRUE(snap.open(path, signature));
+   EXPECT_EQ(snap.rows(), 1u);
+}
+
+TEST_F(gb2gc_snapshot_test, write__should_leave_valid_snapshot__if_written_concurrently)
+{
+   auto write = [&]()
+   {
+      for (auto i = 0; i < 20; ++i)
+         EXPECT_TRUE(snapshot::write(path, signature, benchmarks));
+   };
+   std::thread other(write);
+   write();
+   other.join();
+
+   ASSERT_TRUE(snap.open(path, signature));
+   EXPECT_EQ(read().size(), 2u);
+}
+
+TEST_F(gb2gc_snapshot_test, write__should_fail__if_field_has_mixed_kinds)
+{
+   benchmarks[1]["cpu_time"] = "fast";
+   EXPECT_FALSE(snapshot::write(path, signature, benchmarks));
+}
+
+TEST_F(gb2gc_snapshot_test, input_signature__should_depend_on_content__if_regular_file)
+{
+   input_signature s1;
+   input_signature s2;
+   ASSERT_TRUE(s1.read("benchmark1.json"));
+   ASSERT_TRUE(s2.read("benchmark2.json"));
+   EXPECT_NE(s1.hash, s2.hash);
+   EXPECT_FALSE(input_signature().read("non_existent.json"));
+}
+
+TEST_F(gb2gc_snapshot_test, hash_bytes__should_differ__if_single_byte_differs)
+{
+   std::string a(100, 'a');
+   std::string b(a);
+   b[50] = 'b';
+   EXPECT_EQ(hash_bytes(a.data(), a.size()), hash_bytes(a.data(), a.size()));
+   EXPECT_NE(hash_bytes(a.data(), a.size()), hash_bytes(b.data(), b.size()));
+   EXPECT_NE(hash_bytes(a.data(), 99u), hash_bytes(a.data(), a.size()));
+}
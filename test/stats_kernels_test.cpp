@@ -0,0 +1,66 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "stats_kernels.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_stats_kernels_test : public ::testing::Test
+{
+protected:
+   const std::vector<instruction_set> instruction_sets{
+      instruction_set::scalar, instruction_set::sse2, instruction_set::avx2 };
+
+   // Values with the extremes placed away from the start to exercise all
+   // lanes and the scalar tail
+   static std::vector<double> make_values(std::size_t n)
+   {
+      std::vector<double> values(n);
+      for (auto i = std::size_t(0); i < n; ++i)
+         values[i] = static_cast<double>((i * 37) % 101) - 50.0;
+      if (n > 2)
+      {
+         values[n - 1] = -1000.0;
+         values[n / 2] = 1000.0;
+      }
+      return values;
+   }
+};
+
+TEST_F(gb2gc_stats_kernels_test, kernels__should_match_scalar_kernels__if_any_size)
+{
+   const auto& scalar = get_stats_kernels(instruction_set::scalar);
+   for (auto isa : instruction_sets)
+   {
+      const auto& kernels = get_stats_kernels(isa);
+      for (auto n = std::size_t(1); n < 40; ++n)
+      {
+         const auto values = make_values(n);
+         const auto p = values.data();
+         EXPECT_DOUBLE_EQ(kernels.sum(p, n), scalar.sum(p, n)) << n;
+         EXPECT_EQ(kernels.minimum(p, n), scalar.minimum(p, n)) << n;
+         EXPECT_EQ(kernels.maximum(p, n), scalar.maximum(p, n)) << n;
+         EXPECT_DOUBLE_EQ(kernels.sum_squared_deviations(p, n, 1.5),
+            scalar.sum_squared_deviations(p, n, 1.5)) << n;
+      }
+   }
+}
+
+TEST_F(gb2gc_stats_kernels_test, sum__should_return_zero__if_no_values)
+{
+   for (auto isa : instruction_sets)
+      EXPECT_EQ(get_stats_kernels(isa).sum(nullptr, 0), 0.0);
+}
+
+TEST_F(gb2gc_stats_kernels_test, get_stats_kernels__should_not_exceed_supported_instruction_set__if_requested)
+{
+   const auto supported = supported_instruction_set();
+   EXPECT_LE(static_cast<int>(get_stats_kernels(instruction_set::avx2).isa), static_cast<int>(supported));
+   EXPECT_EQ(get_stats_kernels().isa, supported);
+   EXPECT_EQ(get_stats_kernels(instruction_set::scalar).isa, instruction_set::scalar);
+}
@@ -0,0 +1,70 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "string_pool.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_string_pool_test : public ::testing::Test
+{ };
+
+TEST_F(gb2gc_string_pool_test, intern__should_return_same_code__if_same_string)
+{
+   string_pool pool;
+   const auto a = pool.intern("alpha");
+   const auto b = pool.intern("beta");
+   EXPECT_NE(a, b);
+   EXPECT_EQ(pool.intern(std::string("alpha")), a);
+   EXPECT_EQ(pool.count(), 2u);
+   EXPECT_EQ(pool.str(a), "alpha");
+   EXPECT_STREQ(pool.data(b), "beta");
+   EXPECT_EQ(pool.size(b), 4u);
+}
+
+TEST_F(gb2gc_string_pool_test, find__should_return_npos__if_not_interned)
+{
+   string_pool pool;
+   pool.intern("alpha");
+   EXPECT_EQ(pool.find("beta"), string_pool::npos);
+   EXPECT_EQ(pool.find("alpha"), 0u);
+   EXPECT_EQ(pool.count(), 1u);
+}
+
+TEST_F(gb2gc_string_pool_test, intern__should_store_string__if_larger_than_block)
+{
+   string_pool pool;
+   const std::string large(100000, 'x');
+   const auto small = pool.intern("small");
+   const auto code = pool.intern(large);
+   EXPECT_EQ(pool.str(code), large);
+   EXPECT_EQ(pool.intern("after"), code + 1);
+   EXPECT_STREQ(pool.data(small), "small");
+}
+
+TEST_F(gb2gc_string_pool_test, data__should_remain_valid__if_many_strings_interned)
+{
+   string_pool pool;
+   const auto first = pool.intern("first");
+   const auto p = pool.data(first);
+   for (auto i = 0; i < 100000; ++i)
+      pool.intern(std::to_string(i));
+   EXPECT_EQ(pool.data(first), p);
+   EXPECT_STREQ(p, "first");
+   EXPECT_EQ(pool.count(), 100001u);
+   EXPECT_STREQ(pool.data(pool.find("99999")), "99999");
+}
+
+TEST_F(gb2gc_string_pool_test, intern__should_accept_embedded_nulls__if_size_given)
+{
+   string_pool pool;
+   const auto a = pool.intern("a\0b", 3);
+   const auto b = pool.intern("a", 1);
+   EXPECT_NE(a, b);
+   EXPECT_EQ(pool.size(a), 3u);
+   EXPECT_EQ(std::memcmp(pool.data(a), "a\0b", 3), 0);
+}
@@ -0,0 +1,149 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "svg_chart.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_svg_chart_test : public ::testing::Test
+{
+public:
+   gb2gc_svg_chart_test() : ds({ "X", "A", "B" })
+   {
+      ds.add_row(1, 10, 5);
+      ds.add_row(2, 20, null_type{});
+      ds.add_row(3, 15, 25);
+   }
+
+   std::string render(googlechart::visualization type)
+   {
+      chart.type = type;
+      output_sink sink;
+      chart.write_svg(sink, data_set_view(ds));
+      return sink.str();
+   }
+
+   static size_t count(const std::string& s, const std::string& what)
+   {
+      auto n = size_t(0);
+      for (auto pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1))
+         ++n;
+      return n;
+   }
+
+   data_set ds;
+   svgchart chart;
+};
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_write_svg_root_with_size__if_valid_data_set)
+{
+   chart.width = 300;
+   chart.height = 200;
+   const auto svg = render(googlechart::visualization::line);
+   EXPECT_EQ(svg.find("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"300\" height=\"200\""), 0u);
+   EXPECT_EQ(svg.substr(svg.size() - 7), "</svg>\n");
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_break_line_at_nulls__if_not_interpolated)
+{
+   EXPECT_EQ(count(render(googlechart::visualization::line), "<polyline"), 3u);
+   chart.options.interpolate_nulls = true;
+   EXPECT_EQ(count(render(googlechart::visualization::line), "<polyline"), 2u);
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_draw_point_per_value__if_scatter)
+{
+   EXPECT_EQ(count(render(googlechart::visualization::scatter), "<circle"), 5u);
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_draw_bar_per_value__if_bar)
+{
+   // background rectangle and one bar per non-null value
+   EXPECT_EQ(count(render(googlechart::visualization::bar), "<rect"), 6u);
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_draw_title_legend_and_axis_titles__if_set)
+{
+   chart.options.title = "A & B";
+   chart.options.legend = googlechart_options::position::right;
+   chart.options.horizontal_axis.title = "Key";
+   chart.options.vertical_axis.title = "Time";
+   chart.options.colors = { make_color(0x01, 0xbe, 0xff) };
+   const auto svg = render(googlechart::visualization::line);
+   EXPECT_NE(svg.find(">A &amp; B</text>"), std::string::npos);
+   EXPECT_NE(svg.find(">Key</text>"), std::string::npos);
+   EXPECT_NE(svg.find(">Time</text>"), std::string::npos);
+   EXPECT_NE(svg.find(">A</text>"), std::string::npos);
+   EXPECT_NE(svg.find(">B</text>"), std::string::npos);
+   EXPECT_NE(svg.find("stroke=\"#01beff\""), std::string::npos);
+   EXPECT_NE(svg.find("stroke=\"#dc3912\""), std::string::npos);
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_bucket_values__if_histogram)
+{
+   const auto svg = render(googlechart::visualization::histogram);
+   EXPECT_GT(count(svg, "<rect"), 1u);
+   EXPECT_EQ(svg.find("NaN"), std::string::npos);
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_label_round_ticks__if_fractional_range)
+{
+   data_set fractions({ "X", "Y" });
+   fractions.add_row(0, 0.1);
+   fractions.add_row(1, 0.7);
+   output_sink sink;
+   chart.type = googlechart::visualization::line;
+   chart.write_svg(sink, data_set_view(fractions));
+   const auto svg = sink.str();
+   EXPECT_NE(svg.find(">0.6</text>"), std::string::npos);
+   EXPECT_EQ(svg.find("0000000"), std::string::npos);
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_complete__if_keys_are_large_and_close)
+{
+   // Keys beyond 2^53 which cannot be divided into round integer steps
+   ds = data_set({ "X", "A" });
+   ds.add_row(1000000000000000000.0, 10);
+   ds.add_row(1000000000000000256.0, 20);
+   const auto svg = render(googlechart::visualization::line);
+   EXPECT_EQ(svg.substr(svg.size() - 7), "</svg>\n");
+   EXPECT_EQ(count(svg, "<polyline"), 1u);
+   EXPECT_EQ(count(svg, ">1000000000000000000</text>"), 1u);
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_complete__if_histogram_values_are_large_and_close)
+{
+   ds = data_set({ "X", "A" });
+   ds.add_row(1, 1000000000000000000.0);
+   ds.add_row(2, 1000000000000000256.0);
+   ds.add_row(3, 1000000000000000512.0);
+   const auto svg = render(googlechart::visualization::histogram);
+   EXPECT_EQ(svg.substr(svg.size() - 7), "</svg>\n");
+}
+
+TEST_F(gb2gc_svg_chart_test, write_svg__should_write_finite_coordinates__if_value_range_overflows)
+{
+   // max - min overflows to infinity
+   ds = data_set({ "X", "A" });
+   ds.add_row(-1e308, -1e308);
+   ds.add_row(1e308, 1e308);
+   const googlechart::visualization types[] =
+   {
+      googlechart::visualization::line,
+      googlechart::visualization::bar,
+      googlechart::visualization::scatter,
+      googlechart::visualization::histogram
+   };
+   for (const auto type : types)
+   {
+      const auto svg = render(type);
+      EXPECT_EQ(svg.substr(svg.size() - 7), "</svg>\n");
+      EXPECT_EQ(svg.find("NaN"), std::string::npos) << svg;
+      EXPECT_EQ(svg.find("Infinity"), std::string::npos) << svg;
+   }
+}
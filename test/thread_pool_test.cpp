@@ -0,0 +1,109 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include "thread_pool.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_thread_pool_test : public ::testing::Test
+{ };
+
+TEST_F(gb2gc_thread_pool_test, ctor__should_create_hardware_threads__if_zero_threads)
+{
+   thread_pool pool;
+   EXPECT_EQ(pool.size(), thread_pool::hardware_threads());
+}
+
+TEST_F(gb2gc_thread_pool_test, parallel_for__should_invoke_function_once_per_index__if_valid)
+{
+   thread_pool pool(4);
+   std::vector<std::atomic<int>> counts(100);
+   for (auto& c : counts)
+      c = 0;
+
+   pool.parallel_for(counts.size(), [&](std::size_t i) { ++counts[i]; });
+
+   for (auto& c : counts)
+      EXPECT_EQ(c.load(), 1);
+}
+
+TEST_F(gb2gc_thread_pool_test, parallel_for__should_rethrow__if_function_throws)
+{
+   thread_pool pool(2);
+   EXPECT_THROW(pool.parallel_for(10, [](std::size_t i)
+   {
+      if (i == 5)
+         throw std::runtime_error("failure");
+   }), std::runtime_error);
+}
+
+TEST_F(gb2gc_thread_pool_test, parallel_for__should_complete__if_nested_within_tasks)
+{
+   thread_pool pool(2);
+   std::atomic<int> count(0);
+
+   pool.parallel_for(8, [&](std::size_t)
+   {
+      pool.parallel_for(8, [&](std::size_t) { ++count; });
+   });
+
+   EXPECT_EQ(count.load(), 64);
+}
+
+TEST_F(gb2gc_thread_pool_test, parallel_for__should_complete__if_single_worker_and_nested)
+{
+   thread_pool pool(1);
+   std::atomic<int> count(0);
+
+   pool.parallel_for(4, [&](std::size_t)
+   {
+      pool.parallel_for(4, [&](std::size_t) { ++count; });
+   });
+
+   EXPECT_EQ(count.load(), 16);
+}
+
+TEST_F(gb2gc_thread_pool_test, parallel_for__should_steal_tasks__if_submitted_by_single_worker)
+{
+   thread_pool pool(4);
+   std::mutex mutex;
+   std::set<std::thread::id> threads;
+
+   // All inner tasks are queued on the worker executing the outer task
+   pool.parallel_for(1, [&](std::size_t)
+   {
+      pool.parallel_for(32, [&](std::size_t)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(2));
+         std::lock_guard<std::mutex> lock(mutex);
+         threads.insert(std::this_thread::get_id());
+      });
+   });
+
+   EXPECT_GT(threads.size(), 1u);
+}
+
+TEST_F(gb2gc_thread_pool_test, submit__should_run_task__if_submitted_by_worker)
+{
+   std::atomic<int> count(0);
+   {
+      thread_pool pool(2);
+      pool.submit([&]()
+      {
+         pool.submit([&]() { ++count; });
+         ++count;
+      });
+   } // destructor drains queued tasks
+
+   EXPECT_EQ(count.load(), 2);
+}
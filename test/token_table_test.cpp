@@ -0,0 +1,73 @@
+// Copyright(C) 2019 - 2020 Hkan Sidenvall <ekcoh.git@gmail.com>.
+// This file is subject to the license terms in the LICENSE file found in the
+// root directory of this distribution.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "gb2gc.h"
+#include "token_table.h" // Subject under test (SUT)
+
+using namespace gb2gc;
+
+class gb2gc_token_table_test : public ::testing::Test
+{ };
+
+TEST_F(gb2gc_token_table_test, intern__should_return_same_id__if_same_token)
+{
+   token_table table;
+   const auto a = table.intern("BM_memcpy");
+   const auto b = table.intern("64");
+   EXPECT_NE(a, b);
+   EXPECT_EQ(table.intern(std::string("BM_memcpy")), a);
+   EXPECT_EQ(table.size(), 2u);
+   EXPECT_EQ(table.str(a), "BM_memcpy");
+   EXPECT_EQ(table.str(b), "64");
+}
+
+TEST_F(gb2gc_token_table_test, find__should_return_no_token__if_not_interned)
+{
+   token_table table;
+   const auto a = table.intern("a");
+   EXPECT_EQ(table.find("a"), a);
+   EXPECT_EQ(table.find("b"), no_token);
+   EXPECT_EQ(table.size(), 1u);
+}
+
+TEST_F(gb2gc_token_table_test, intern__should_keep_tokens__if_many_tokens)
+{
+   token_table table;
+   for (auto i = 0; i < 10000; ++i)
+      table.intern(std::to_string(i));
+   for (auto i = 0; i < 10000; ++i)
+      EXPECT_EQ(table.str(table.find(std::to_string(i))), std::to_string(i));
+}
+
+TEST_F(gb2gc_token_table_test, number__should_parse_token__if_numeric)
+{
+   token_table table;
+   EXPECT_EQ(table.number(table.intern("4096")), 4096.0);
+   EXPECT_EQ(table.number(table.intern("4096")), 4096.0);
+   EXPECT_THROW(table.number(table.intern("BM_memcpy")), std::invalid_argument);
+}
+
+TEST_F(gb2gc_token_table_test, add__should_tokenize_like_split__if_name)
+{
+   const char* names[] = { "BM_memcpy/8/64", "BM_a//b", "BM_a/", "/BM_a", "" };
+
+   tokenized_names tn;
+   for (auto name : names)
+      tn.add(name);
+
+   ASSERT_EQ(tn.size(), 5u);
+   for (auto i = 0u; i < tn.size(); ++i)
+   {
+      const auto expected = split(names[i], '/');
+      ASSERT_EQ(tn.count(i), expected.size());
+      for (auto j = 0u; j < expected.size(); ++j)
+         EXPECT_EQ(tn.table().str(tn.begin(i)[j]), expected[j]);
+   }
+   EXPECT_EQ(tn.begin(0)[0], tn.table().find("BM_memcpy"));
+   EXPECT_EQ(tn.begin(1)[0], tn.begin(2)[0]);
+}
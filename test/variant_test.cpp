@@ -26,10 +26,10 @@ TEST_F(gb2gc_variant_test,
 }
 
 template<class T>
-void assert_string_conversion(std::stringstream& ss, T value)
+void assert_string_conversion(std::stringstream& ss, T value, const char* expected)
 {
    ss << variant(T(value));
-   EXPECT_EQ(ss.str(), std::to_string(T(value)));
+   EXPECT_EQ(ss.str(), expected);
    reset(ss);
 }
 
@@ -42,17 +42,28 @@ TEST_F(gb2gc_variant_test,
    EXPECT_EQ(ss.str(), "'null'");
    reset(ss);
 
-   assert_string_conversion<unsigned short>(ss, 123U);
-   assert_string_conversion<unsigned int>(ss, 123U);
-   assert_string_conversion<unsigned long>(ss, 123UL);
-   assert_string_conversion<unsigned long long>(ss, 123ULL);
+   assert_string_conversion<unsigned short>(ss, 123U, "123");
+   assert_string_conversion<unsigned int>(ss, 123U, "123");
+   assert_string_conversion<unsigned long>(ss, 123UL, "123");
+   assert_string_conversion<unsigned long long>(ss, 18446744073709551615ULL, "18446744073709551615");
 
-   assert_string_conversion<short>(ss, 123);
-   assert_string_conversion<int>(ss, 123);
-   assert_string_conversion<long>(ss, 123L);
-   assert_string_conversion<long long>(ss, 123LL);
+   assert_string_conversion<short>(ss, -123, "-123");
+   assert_string_conversion<int>(ss, 123, "123");
+   assert_string_conversion<long>(ss, 123L, "123");
+   assert_string_conversion<long long>(ss, -9223372036854775807LL - 1, "-9223372036854775808");
 
-   assert_string_conversion<float>(ss, 1.23456789f);
-   assert_string_conversion<double>(ss, 1.23456789);
-   assert_string_conversion<long double>(ss, 1.23456789L);
-}
\ No newline at end of file
+   assert_string_conversion<float>(ss, 1.23456789f, "1.2345679");
+   assert_string_conversion<double>(ss, 1.23456789, "1.23456789");
+   assert_string_conversion<long double>(ss, 1.23456789L, "1.23456789");
+}
+
+TEST_F(gb2gc_variant_test,
+   output_stream_operator__should_write_shortest_round_trip_number__if_floating_point)
+{
+   EXPECT_EQ(to_string(variant(3.2e-05)), "0.000032");
+   EXPECT_EQ(to_string(variant(1e-09)), "1e-9");
+   EXPECT_EQ(to_string(variant(1e21)), "1e+21");
+   EXPECT_EQ(to_string(variant(0.1 + 0.2)), "0.30000000000000004");
+   EXPECT_EQ(to_string(variant(29836.0)), "29836");
+   EXPECT_EQ(to_string(variant(-0.0)), "0");
+}